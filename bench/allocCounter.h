@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// счетчик глобальных operator new во всем процессе бенчмарков
+std::uint64_t allocationCount();
+// текущий резидентный размер процесса, байт (0, если неизвестен)
+std::size_t residentBytes();
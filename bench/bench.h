@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// простейший замер времени для бенчмарков
+template <typename Fn>
+double measureMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// лучший из нескольких прогонов - меньше шума от планировщика
+template <typename Fn>
+double bestOfMs(int repeats, Fn&& fn) {
+    double best = measureMs(fn);
+    for (int i = 1; i < repeats; ++i) {
+        best = std::min(best, measureMs(fn));
+    }
+    return best;
+}
+
+// результат одного замера; n - число операций в замере
+struct BenchResult {
+    std::string bench;
+    std::string name;
+    std::size_t n;
+    double ms;
+};
+
+inline std::vector<BenchResult>& benchResults() {
+    static std::vector<BenchResult> results;
+    return results;
+}
+
+inline std::string& currentBench() {
+    static std::string name;
+    return name;
+}
+
+// печатает и запоминает для JSON-отчета
+inline void report(const std::string& name, std::size_t n, double ms) {
+    std::printf("%-32s n=%-9zu %10.3f ms %10.2f ns/op\n", name.c_str(), n, ms, n ? ms * 1e6 / n : 0.0);
+    benchResults().push_back({currentBench(), name, n, ms});
+}
+
+// регистрация бенчмарков, запускаются из bench_main.cpp
+struct BenchCase {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<BenchCase>& benchRegistry() {
+    static std::vector<BenchCase> registry;
+    return registry;
+}
+
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, void (*fn)()) { benchRegistry().push_back({name, fn}); }
+};
+
+#define BENCH(name)                                                  \
+    static void bench_##name();                                      \
+    static BenchRegistrar bench_registrar_##name(#name, bench_##name); \
+    static void bench_##name()
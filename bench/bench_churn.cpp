@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "allocCounter.h"
+#include "bench.h"
+#include "factory.h"
+#include "fightVisitor.h"
+#include "registry.h"
+#include "rng.h"
+#include "world.h"
+
+namespace {
+
+const std::size_t POPULATION = 100000;
+const std::size_t ROUNDS = 50;
+const std::size_t CHURN = 5000;   // убитых и рожденных за раунд
+const std::size_t FIGHTS = 20000; // фасадов-пар за раунд
+
+// раунд: бои через фасады, часть нпс погибает и рождается заново.
+// pooled = слоты мертвых переиспользуются и фасады берутся из пула мира,
+// иначе мир только растет, а фасады создает фабрика через make_shared
+void churn(bool pooled) {
+    World world;
+    for (std::size_t i = 0; i < POPULATION; ++i) {
+        world.add(NpcType::Knight, "Knight_" + std::to_string(i), static_cast<int>(i % 101), 7);
+    }
+
+    std::size_t names_before = world.nameBytes();
+    std::size_t rss_before = residentBytes();
+    std::uint64_t allocs_before = allocationCount();
+    std::size_t spawned = 0;
+
+    double ms = measureMs([&] {
+        for (std::uint32_t round = 0; round < ROUNDS; ++round) {
+            std::size_t wins = 0;
+            for (std::uint32_t f = 0; f < FIGHTS; ++f) {
+                CounterRng rng(1, RngStream::Local, round, f);
+                auto a = static_cast<World::Id>(rng.below(static_cast<int>(world.size())));
+                auto d = static_cast<World::Id>(rng.below(static_cast<int>(world.size())));
+                std::shared_ptr<NPC> attacker, defender;
+                if (pooled) {
+                    attacker = world.npc(a);
+                    defender = world.npc(d);
+                } else {
+                    attacker = NPCFactory::create(world.getType(a), std::string(world.getName(a)), world.getX(a), world.getY(a));
+                    defender = NPCFactory::create(world.getType(d), std::string(world.getName(d)), world.getX(d), world.getY(d));
+                }
+                FightVisitor visitor(attacker);
+                wins += visitor.visit(defender);
+            }
+
+            std::vector<World::Id> killed;
+            for (std::uint32_t k = 0; k < CHURN; ++k) {
+                CounterRng rng(1, RngStream::Dice, round, k);
+                auto id = static_cast<World::Id>(rng.below(static_cast<int>(world.size())));
+                if (!world.isAlive(id)) continue;
+                world.kill(id);
+                killed.push_back(id);
+            }
+            for (World::Id id : killed) {
+                std::string name = "Spawn_" + std::to_string(spawned++);
+                if (pooled) {
+                    world.release(id);
+                    world.spawn(NpcType::Dragon, name, 1, 1);
+                } else {
+                    world.add(NpcType::Dragon, name, 1, 1);
+                }
+            }
+            (void)wins;
+        }
+    });
+
+    std::uint64_t allocs = allocationCount() - allocs_before;
+    long long rss_delta = static_cast<long long>(residentBytes()) - static_cast<long long>(rss_before);
+    const char* label = pooled ? "pooled slots+facades" : "make_shared, no reuse";
+    report(label, ROUNDS * FIGHTS, ms);
+    std::printf("  allocations: %llu (%.2f per fight) | world slots: %zu | RSS delta: %.1f MB\n",
+                static_cast<unsigned long long>(allocs), static_cast<double>(allocs) / (ROUNDS * FIGHTS),
+                world.size(), rss_delta / (1024.0 * 1024.0));
+    std::printf("  name table: %.2f MB -> %.2f MB\n", names_before / (1024.0 * 1024.0),
+                world.nameBytes() / (1024.0 * 1024.0));
+}
+
+}
+
+BENCH(npc_churn) {
+    churn(false);
+    churn(true);
+}
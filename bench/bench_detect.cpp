@@ -0,0 +1,62 @@
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "detect.h"
+
+namespace {
+
+struct Block {
+    std::vector<int> xs, ys, kills;
+};
+
+Block makeBlock(std::size_t n) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> coord(0, 90);
+    std::uniform_int_distribution<int> kind(0, 2);
+    static constexpr int kill[3] = {10, 30, 10};
+
+    Block block;
+    for (std::size_t i = 0; i < n; ++i) {
+        block.xs.push_back(coord(gen));
+        block.ys.push_back(coord(gen));
+        block.kills.push_back(kill[kind(gen)]);
+    }
+    return block;
+}
+
+template <typename Kernel>
+std::uint32_t runKernel(const Block& block, Kernel kernel) {
+    // каждый нпс против всех блоков по KILL_BLOCK
+    std::uint32_t acc = 0;
+    std::size_t n = block.xs.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t begin = 0; begin < n; begin += KILL_BLOCK) {
+            std::size_t count = std::min(KILL_BLOCK, n - begin);
+            KillMasks m = kernel(block.xs[i], block.ys[i], block.kills[i],
+                                 &block.xs[begin], &block.ys[begin], &block.kills[begin], count);
+            acc += m.by_self ^ m.by_other;
+        }
+    }
+    return acc;
+}
+
+}
+
+BENCH(kill_range_kernel) {
+    for (std::size_t n : {256u, 1024u, 4096u}) {
+        auto block = makeBlock(n);
+
+        std::uint32_t scalar = 0;
+        double scalar_ms = measureMs([&] { scalar = runKernel(block, killRangeMasksScalar); });
+        report("kernel scalar", n * n, scalar_ms);
+
+        std::uint32_t simd = 0;
+        double simd_ms = measureMs([&] { simd = runKernel(block, killRangeMasks); });
+        report(std::string("kernel ") + killRangeKernelName(), n * n, simd_ms);
+
+        if (scalar != simd) {
+            std::printf("mismatch: scalar=%u simd=%u\n", scalar, simd);
+        }
+    }
+}
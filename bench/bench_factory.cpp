@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "bench.h"
+#include "factory.h"
+#include "registry.h"
+#include "rng.h"
+#include "threadPool.h"
+
+namespace {
+
+void reportRate(double bytes, double ms) {
+    std::printf("  %.1f MB/s\n", bytes / (1024.0 * 1024.0) / (ms / 1000.0));
+}
+
+}
+
+// построчный create/save против пакетных load/save на 1M нпс
+BENCH(text_bulk_io) {
+    const std::size_t count = 1000000;
+
+    World world;
+    world.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+        auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+        world.add(type, std::string(typeName(type)) + "_" + std::to_string(i), rng.below(101), rng.below(101));
+    }
+
+    std::string text;
+    double loop_save = measureMs([&] {
+        std::ostringstream os;
+        for (World::Id id = 0; id < world.size(); ++id) NPCFactory::save(world.npc(id), os);
+        text = os.str();
+    });
+    report("per-NPC save", count, loop_save);
+    reportRate(text.size(), loop_save);
+
+    double bulk_save = measureMs([&] {
+        std::ostringstream os;
+        NPCFactory::save(world, os);
+        text = os.str();
+    });
+    report("bulk save", count, bulk_save);
+    reportRate(text.size(), bulk_save);
+
+    double loop_load = measureMs([&] {
+        World loaded;
+        loaded.reserve(count);
+        std::istringstream is(text);
+        while (auto npc = NPCFactory::create(is)) loaded.add(*npc);
+    });
+    report("per-NPC create(istream)", count, loop_load);
+    reportRate(text.size(), loop_load);
+
+    double bulk_load = measureMs([&] {
+        World loaded;
+        NPCFactory::load(text, loaded);
+    });
+    report("bulk load", count, bulk_load);
+    reportRate(text.size(), bulk_load);
+
+    ThreadPool pool(0);
+    double parallel_load = measureMs([&] {
+        World loaded;
+        NPCFactory::load(text, loaded, &pool);
+    });
+    report("bulk load workers=" + std::to_string(pool.size()), count, parallel_load);
+    reportRate(text.size(), parallel_load);
+}
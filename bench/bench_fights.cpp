@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "fightResolver.h"
+#include "registry.h"
+#include "rng.h"
+#include "simulation.h"
+
+namespace {
+
+const int COUNT = 100000;
+const int SIDE = 3000;
+
+// плотная карта: на тик приходятся сотни тысяч боев
+World denseWorld() {
+    World world;
+    world.reserve(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+        auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+        world.add(type, "N", rng.below(SIDE), rng.below(SIDE));
+    }
+    return world;
+}
+
+}
+
+// фаза боев одного тика: по одному и пачками без общих нпс от 2 до N потоков
+BENCH(fight_resolution) {
+    std::vector<FightTask> fights;
+    {
+        World world = denseWorld();
+        ThreadPool pool(1);
+        Simulation simulation(world, pool);
+        simulation.indexWorld();
+        simulation.detect(1, fights);
+    }
+
+    // мир каждый раз свежий, его сборка в замер не входит
+    auto best = [&](auto&& resolve) {
+        double ms = 0;
+        for (int r = 0; r < 3; ++r) {
+            World world = denseWorld();
+            double run = measureMs([&] { resolve(world); });
+            ms = r == 0 ? run : std::min(ms, run);
+        }
+        return ms;
+    };
+
+    double base_ms = best([&](World& world) { resolveFights(world, fights, nullptr); });
+    report("serial", fights.size(), base_ms);
+
+    std::size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t workers = 2; workers <= std::max<std::size_t>(2, max_workers); workers *= 2) {
+        ThreadPool pool(workers);
+        FightResolver resolver(pool);
+        double ms = best([&](World& world) { resolver.resolve(world, fights, nullptr); });
+        report("batched workers=" + std::to_string(workers), fights.size(), ms);
+        std::printf("  %zu batches, speedup x%.2f\n", resolver.batchCount(), base_ms / ms);
+    }
+}
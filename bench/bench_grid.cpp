@@ -0,0 +1,82 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "grid.h"
+
+namespace {
+
+struct Point {
+    int x, y, kill;
+};
+
+// плотность постоянна: карта растет вместе с числом нпс
+std::vector<Point> makePoints(std::size_t n) {
+    std::mt19937 gen(1);
+    int side = static_cast<int>(std::sqrt(static_cast<double>(n)) * 20);
+    std::uniform_int_distribution<int> coord(0, side);
+    std::uniform_int_distribution<int> kind(0, 2);
+
+    std::vector<Point> points(n);
+    for (auto& p : points) {
+        static constexpr int kill[3] = {10, 30, 10};
+        p = {coord(gen), coord(gen), kill[kind(gen)]};
+    }
+    return points;
+}
+
+bool inRange(const Point& a, const Point& b) {
+    int dx = a.x - b.x;
+    int dy = a.y - b.y;
+    double d = std::sqrt(dx * dx + dy * dy);
+    return d <= a.kill || d <= b.kill;
+}
+
+std::size_t naivePairs(const std::vector<Point>& points) {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        for (std::size_t j = i + 1; j < points.size(); ++j) {
+            if (inRange(points[i], points[j])) ++found;
+        }
+    }
+    return found;
+}
+
+std::size_t gridPairs(const std::vector<Point>& points, const SpatialGrid& grid) {
+    std::size_t found = 0;
+    grid.forEachCandidatePair([&](SpatialGrid::Id a, SpatialGrid::Id b) {
+        if (inRange(points[a], points[b])) ++found;
+    });
+    return found;
+}
+
+}
+
+BENCH(grid_detection) {
+    for (std::size_t n : {1000u, 10000u, 100000u, 1000000u}) {
+        auto points = makePoints(n);
+
+        SpatialGrid grid(30);
+        double build = measureMs([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                grid.insert(static_cast<SpatialGrid::Id>(i), points[i].x, points[i].y);
+            }
+        });
+        report("grid build", n, build);
+
+        std::size_t found = 0;
+        double detect = measureMs([&] { found = gridPairs(points, grid); });
+        report("grid detect", n, detect);
+
+        // полный перебор квадратичен, на больших n не запускаем
+        if (n <= 10000) {
+            std::size_t expected = 0;
+            double naive = measureMs([&] { expected = naivePairs(points); });
+            report("naive detect", n, naive);
+            if (expected != found) {
+                std::printf("mismatch: naive=%zu grid=%zu\n", expected, found);
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+#include "bench.h"
+
+namespace {
+
+std::string escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// один объект на запуск: метка (например, хэш коммита) + все замеры
+void writeJson(std::ostream& os, const std::string& label) {
+    os << "{\n  \"label\": \"" << escape(label) << "\",\n"
+       << "  \"timestamp\": " << std::time(nullptr) << ",\n"
+       << "  \"results\": [\n";
+    const auto& results = benchResults();
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << "    {\"bench\": \"" << escape(r.bench) << "\", \"name\": \"" << escape(r.name)
+           << "\", \"n\": " << r.n << ", \"ms\": " << r.ms
+           << ", \"ns_per_op\": " << (r.n ? r.ms * 1e6 / r.n : 0.0) << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+}
+
+// bench [фильтр] [--json файл|-] [--label метка]
+// без фильтра запускаются все бенчмарки, иначе только те, чье имя содержит фильтр;
+// с --json - в stdout идет только JSON, отчет для человека уходит в stderr
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    std::string json_path;
+    std::string label;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            label = argv[++i];
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    // бенчмарки печатают printf-ом, поэтому stdout на время прогона подменяется на stderr
+    int json_fd = -1;
+    if (json_path == "-") {
+        std::fflush(stdout);
+        json_fd = ::dup(STDOUT_FILENO);
+        ::dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+
+    for (const auto& bench : benchRegistry()) {
+        if (filter && std::strstr(bench.name, filter) == nullptr) continue;
+        std::printf("== %s\n", bench.name);
+        currentBench() = bench.name;
+        bench.fn();
+    }
+
+    if (json_fd >= 0) {
+        std::fflush(stdout);
+        ::dup2(json_fd, STDOUT_FILENO);
+        ::close(json_fd);
+    }
+
+    if (json_path == "-") {
+        writeJson(std::cout, label);
+    } else if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::fprintf(stderr, "cannot write %s\n", json_path.c_str());
+            return 1;
+        }
+        writeJson(out, label);
+    }
+    return 0;
+}
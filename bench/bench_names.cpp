@@ -0,0 +1,86 @@
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocCounter.h"
+#include "bench.h"
+#include "registry.h"
+#include "rng.h"
+#include "world.h"
+
+namespace {
+
+const std::size_t COUNT = 1000000;
+
+NpcType kindOf(std::size_t i) {
+    CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+    return static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+}
+
+// RSS тут не годится: память прошлых замеров уже взята у системы и переиспользуется
+void reportMemory(std::size_t bytes, std::uint64_t allocs_before) {
+    std::printf("  %.1f bytes/NPC for names, %.2f allocations/NPC\n", static_cast<double>(bytes) / COUNT,
+                static_cast<double>(allocationCount() - allocs_before) / COUNT);
+}
+
+}
+
+// запуск: генерация имен "Type_i" и заполнение хранилища на 1M нпс
+BENCH(name_storage) {
+    {
+        // как раньше: строка на имя, склейка через std::string
+        std::uint64_t allocs = allocationCount();
+        std::vector<std::string> names;
+        double ms = measureMs([&] {
+            names.reserve(COUNT);
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                names.push_back(std::string(typeName(kindOf(i))) + "_" + std::to_string(i));
+            }
+        });
+        report("vector<string> names", COUNT, ms);
+        std::size_t bytes = names.capacity() * sizeof(std::string);
+        for (const auto& name : names) {
+            if (name.capacity() > 15) bytes += name.capacity() + 1;  // вне SSO
+        }
+        reportMemory(bytes, allocs);
+    }
+    {
+        std::uint64_t allocs = allocationCount();
+        NameTable names;
+        double ms = measureMs([&] {
+            names.reserve(COUNT, COUNT * 12);
+            std::array<char, 64> buffer;
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                std::string_view type = typeName(kindOf(i));
+                char* end = std::copy(type.begin(), type.end(), buffer.data());
+                *end++ = '_';
+                end = std::to_chars(end, buffer.data() + buffer.size(), i).ptr;
+                names.add({buffer.data(), static_cast<std::size_t>(end - buffer.data())});
+            }
+        });
+        report("NameTable names", COUNT, ms);
+        reportMemory(names.bytes() + (names.size() + 1) * sizeof(std::uint32_t), allocs);
+    }
+    {
+        std::uint64_t allocs = allocationCount();
+        World world;
+        double ms = measureMs([&] {
+            world.reserve(COUNT);
+            std::array<char, 64> buffer;
+            for (std::size_t i = 0; i < COUNT; ++i) {
+                NpcType type = kindOf(i);
+                std::string_view name = typeName(type);
+                char* end = std::copy(name.begin(), name.end(), buffer.data());
+                *end++ = '_';
+                end = std::to_chars(end, buffer.data() + buffer.size(), i).ptr;
+                world.add(type, {buffer.data(), static_cast<std::size_t>(end - buffer.data())}, 0, 0);
+            }
+        });
+        report("World startup", COUNT, ms);
+        // смещение в таблице + id имени в слоте
+        reportMemory(world.nameBytes() + world.size() * 2 * sizeof(std::uint32_t), allocs);
+    }
+}
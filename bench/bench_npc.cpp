@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "factory.h"
+#include "fightVisitor.h"
+#include "asyncFileObserver.h"
+#include "observer.h"
+#include "registry.h"
+#include "rng.h"
+
+namespace {
+
+const int REPEATS = 3;
+
+std::vector<std::shared_ptr<NPC>> makeNpcs(std::size_t n) {
+    std::vector<std::shared_ptr<NPC>> npcs;
+    npcs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+        auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+        npcs.push_back(NPCFactory::create(type, std::string(typeName(type)) + "_" + std::to_string(i),
+                                          rng.below(101), rng.below(101)));
+    }
+    return npcs;
+}
+
+// не дает компилятору выбросить результат
+volatile double sink;
+
+}
+
+BENCH(npc_move_random) {
+    auto npcs = makeNpcs(10000);
+    const int rounds = 20;
+    double ms = bestOfMs(REPEATS, [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (auto& npc : npcs) npc->moveRandom();
+        }
+    });
+    report("NPC::moveRandom", npcs.size() * rounds, ms);
+}
+
+BENCH(npc_distance) {
+    auto npcs = makeNpcs(2000);
+    double ms = bestOfMs(REPEATS, [&] {
+        double acc = 0;
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            for (std::size_t j = i + 1; j < npcs.size(); ++j) {
+                acc += npcs[i]->distance(npcs[j]);
+            }
+        }
+        sink = acc;
+    });
+    report("NPC::distance", npcs.size() * (npcs.size() - 1) / 2, ms);
+}
+
+BENCH(fight_dispatch) {
+    auto npcs = makeNpcs(1000);
+    std::vector<std::shared_ptr<FightVisitor>> visitors;
+    for (const auto& npc : npcs) {
+        visitors.push_back(std::make_shared<FightVisitor>(npc));
+    }
+
+    std::size_t ops = visitors.size() * npcs.size();
+    double visit_ms = bestOfMs(REPEATS, [&] {
+        int wins = 0;
+        for (const auto& visitor : visitors) {
+            for (const auto& defender : npcs) wins += visitor->visit(defender);
+        }
+        sink = wins;
+    });
+    report("FightVisitor::visit", ops, visit_ms);
+
+    double accept_ms = bestOfMs(REPEATS, [&] {
+        int wins = 0;
+        for (const auto& visitor : visitors) {
+            for (const auto& defender : npcs) wins += defender->accept(visitor);
+        }
+        sink = wins;
+    });
+    report("NPC::accept", ops, accept_ms);
+
+    // как в потоке боев до оптимизаций: новый визитор на каждый бой
+    double fresh_ms = bestOfMs(REPEATS, [&] {
+        int wins = 0;
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            for (const auto& defender : npcs) wins += std::make_shared<FightVisitor>(npcs[i])->visit(defender);
+        }
+        sink = wins;
+    });
+    report("make_shared<FightVisitor>+visit", ops, fresh_ms);
+
+    // по id мира: визитор на стеке, без фасадов
+    World world;
+    for (const auto& npc : npcs) world.add(*npc);
+    double world_ms = bestOfMs(REPEATS, [&] {
+        int wins = 0;
+        WorldFightVisitor visitor(world);
+        for (World::Id a = 0; a < world.size(); ++a) {
+            for (World::Id d = 0; d < world.size(); ++d) wins += visitor.visit(a, d);
+        }
+        sink = wins;
+    });
+    report("WorldFightVisitor::visit", ops, world_ms);
+}
+
+BENCH(factory_io) {
+    auto npcs = makeNpcs(100000);
+
+    std::string text;
+    double save_ms = bestOfMs(REPEATS, [&] {
+        std::ostringstream os;
+        for (const auto& npc : npcs) NPCFactory::save(npc, os);
+        text = os.str();
+    });
+    report("NPCFactory::save", npcs.size(), save_ms);
+
+    double load_ms = bestOfMs(REPEATS, [&] {
+        std::istringstream is(text);
+        std::size_t loaded = 0;
+        while (auto npc = NPCFactory::create(is)) ++loaded;
+        sink = static_cast<double>(loaded);
+    });
+    report("NPCFactory::create(istream)", npcs.size(), load_ms);
+
+    double create_ms = bestOfMs(REPEATS, [&] {
+        std::size_t made = 0;
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            made += NPCFactory::create(NpcType::Toad, "Toad", 1, 2) != nullptr;
+        }
+        sink = static_cast<double>(made);
+    });
+    report("NPCFactory::create(type)", npcs.size(), create_ms);
+}
+
+BENCH(observers) {
+    auto npcs = makeNpcs(1000);
+    const std::size_t events = 100000;
+
+    // вывод TextObserver уходит в пустой буфер, меряется только форматирование
+    std::ostringstream devnull;
+    auto* old = std::cout.rdbuf(devnull.rdbuf());
+    TextObserver text;
+    double text_ms = bestOfMs(REPEATS, [&] {
+        devnull.str({});
+        for (std::size_t i = 0; i < events; ++i) {
+            text.onFight(npcs[i % npcs.size()], npcs[(i + 1) % npcs.size()], true);
+        }
+    });
+    std::cout.rdbuf(old);
+    report("TextObserver::onFight", events, text_ms);
+
+    const char* path = "bench_observer_log.txt";
+    double file_ms;
+    {
+        FileObserver file(path);
+        file_ms = bestOfMs(REPEATS, [&] {
+            for (std::size_t i = 0; i < events; ++i) {
+                file.onFight(npcs[i % npcs.size()], npcs[(i + 1) % npcs.size()], true);
+            }
+        });
+    }
+    std::remove(path);
+    report("FileObserver::onFight", events, file_ms);
+
+    // в замер входит только onFight; запись идет в фоне
+    double async_ms;
+    {
+        AsyncFileObserver async(path, {1 << 16, std::chrono::milliseconds(50), OverflowPolicy::Block});
+        async_ms = bestOfMs(REPEATS, [&] {
+            for (std::size_t i = 0; i < events; ++i) {
+                async.onFight(npcs[i % npcs.size()], npcs[(i + 1) % npcs.size()], true);
+            }
+        });
+    }
+    std::remove(path);
+    report("AsyncFileObserver::onFight", events, async_ms);
+}
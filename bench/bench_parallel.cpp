@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "registry.h"
+#include "rng.h"
+#include "simulation.h"
+
+// ускорение фаз движения и поиска боев от 1 до N потоков
+BENCH(parallel_scaling) {
+    const int count = 5000;
+    const std::uint32_t ticks = 20;
+    std::size_t max_workers = std::max(1u, std::thread::hardware_concurrency());
+
+    double base_ms = 0;
+    for (std::size_t workers = 1; workers <= max_workers; workers *= 2) {
+        World world;
+        world.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+            auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+            world.add(*makeNpc(type, "N", rng.below(101), rng.below(101)));
+        }
+
+        ThreadPool pool(workers);
+        Simulation simulation(world, pool);
+        simulation.indexWorld();
+
+        std::vector<FightTask> fights;
+        double ms = measureMs([&] {
+            for (std::uint32_t tick = 1; tick <= ticks; ++tick) {
+                fights.clear();
+                simulation.move(tick);
+                simulation.detect(tick, fights);
+            }
+        });
+        if (workers == 1) base_ms = ms;
+
+        report("move+detect workers=" + std::to_string(workers), count, ms);
+        std::printf("  speedup x%.2f\n", base_ms / ms);
+    }
+}
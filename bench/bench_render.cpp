@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <cstdio>
+
+#include "bench.h"
+#include "renderer.h"
+#include "rng.h"
+
+namespace {
+
+const int WIDTH = 80;
+const int HEIGHT = 30;
+const int FRAMES = 1000;
+
+// кадр с n нпс, сдвинутыми на шаге frame
+void fillFrame(TerminalRenderer& renderer, int n, std::uint32_t frame) {
+    renderer.beginFrame();
+    for (int i = 0; i < n; ++i) {
+        CounterRng rng(1, RngStream::Move, frame, static_cast<std::uint32_t>(i));
+        renderer.plot(rng.below(WIDTH - 1), rng.below(HEIGHT - 1), 'D');
+    }
+}
+
+}
+
+// запуск: сборка кадра 80x30 целиком и только изменений (запись в терминал не входит)
+BENCH(render_frame) {
+    std::size_t bytes = 0;
+    {
+        TerminalRenderer renderer(WIDTH, HEIGHT, false);
+        double ms = bestOfMs(3, [&] {
+            for (int f = 0; f < FRAMES; ++f) {
+                fillFrame(renderer, 200, static_cast<std::uint32_t>(f));
+                bytes = renderer.finishFrame("status").size();
+            }
+        });
+        report("render_full_frame", FRAMES, ms);
+        std::printf("  %zu bytes/frame\n", bytes);
+    }
+    {
+        TerminalRenderer renderer(WIDTH, HEIGHT, true, 60);
+        double ms = bestOfMs(3, [&] {
+            for (int f = 0; f < FRAMES; ++f) {
+                // половина нпс стоит на месте
+                fillFrame(renderer, 100, 0);
+                for (int i = 0; i < 100; ++i) {
+                    CounterRng rng(2, RngStream::Move, static_cast<std::uint32_t>(f), static_cast<std::uint32_t>(i));
+                    renderer.plot(rng.below(WIDTH - 1), rng.below(HEIGHT - 1), 'K');
+                }
+                bytes = renderer.finishFrame("status").size();
+            }
+        });
+        report("render_diff_frame", FRAMES, ms);
+        std::printf("  %zu bytes/frame\n", bytes);
+    }
+}
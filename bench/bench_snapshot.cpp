@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "bench.h"
+#include "factory.h"
+#include "registry.h"
+#include "rng.h"
+#include "snapshot.h"
+
+// текстовый формат фабрики против двоичного снимка на одном и том же мире
+BENCH(snapshot_io) {
+    const std::size_t count = 1000000;
+    const char* text_path = "bench_world.txt";
+    const char* snap_path = "bench_world.bin";
+
+    World world;
+    world.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+        auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+        world.add(type, std::string(typeName(type)) + "_" + std::to_string(i), rng.below(101), rng.below(101));
+    }
+
+    double text_save = measureMs([&] {
+        std::ofstream out(text_path);
+        for (World::Id id = 0; id < world.size(); ++id) NPCFactory::save(world.npc(id), out);
+    });
+    report("text save", count, text_save);
+
+    double text_load = measureMs([&] {
+        World loaded;
+        loaded.reserve(count);
+        std::ifstream in(text_path);
+        while (auto npc = NPCFactory::create(in)) loaded.add(*npc);
+    });
+    report("text load", count, text_load);
+
+    double snap_save = measureMs([&] { saveSnapshot(world, snap_path); });
+    report("snapshot save", count, snap_save);
+
+    double snap_open = measureMs([&] {
+        SnapshotView view(snap_path);
+        std::printf("  snapshot %zu NPCs, first %s\n", view.size(), std::string(view.getName(0)).c_str());
+    });
+    report("snapshot mmap+validate", count, snap_open);
+
+    double snap_load = measureMs([&] {
+        World loaded;
+        loadSnapshot(snap_path, loaded);
+    });
+    report("snapshot load into World", count, snap_load);
+
+    std::remove(text_path);
+    std::remove(snap_path);
+}
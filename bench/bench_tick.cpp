@@ -0,0 +1,50 @@
+#include <cmath>
+#include <string>
+
+#include "bench.h"
+#include "registry.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "worldConfig.h"
+
+namespace {
+
+// плотность как у 1M нпс на карте 100k x 100k
+const double NPC_DENSITY = 1e-4;
+
+}
+
+// сквозной тик (move + detect + resolve) в безголовом режиме, карта растет с населением
+BENCH(end_to_end_tick) {
+    const std::uint32_t ticks = 10;
+    const WorldConfig saved = worldConfig();
+
+    for (std::size_t count : {1000u, 10000u, 100000u, 1000000u}) {
+        WorldConfig config;
+        config.width = config.height = static_cast<int>(std::sqrt(count / NPC_DENSITY));
+        config.npc_count = count;
+        setWorldConfig(config);
+
+        World world;
+        world.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            CounterRng rng(1, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+            auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+            world.add(type, std::string(typeName(type)), rng.below(config.width), rng.below(config.height));
+        }
+
+        ThreadPool pool(0);
+        Simulation simulation(world, pool);
+        simulation.indexWorld();
+        TickScheduler scheduler(simulation, [&](std::uint32_t, const std::vector<FightTask>& fights) {
+            return resolveFights(world, fights, nullptr);
+        });
+
+        RunStats stats = scheduler.runHeadless(ticks);
+        report("tick npcs=" + std::to_string(count), stats.ticks, stats.seconds * 1000);
+        std::printf("  map %dx%d, %.0f ticks/s, %.0f NPC updates/s\n", config.width, config.height,
+                    stats.ticksPerSecond(), stats.updatesPerSecond());
+    }
+
+    setWorldConfig(saved);
+}
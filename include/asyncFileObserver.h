@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "boundedQueue.h"
+#include "npcType.h"
+#include "observer.h"
+
+// что делать, когда кольцо записей заполнено
+enum class OverflowPolicy { Block, Drop };
+
+struct AsyncLogConfig {
+    std::size_t buffer_size = 1 << 14;                     // записей в кольце
+    std::chrono::milliseconds flush_interval{50};          // как часто писатель сбрасывает пачку
+    OverflowPolicy overflow = OverflowPolicy::Block;
+};
+
+// компактная запись боя фиксированного размера; имя длиннее NAME_CAP - 1 не обрезается,
+// а уходит в отдельную таблицу наблюдателя, в записи остается его номер
+struct FightRecord {
+    static constexpr std::size_t NAME_CAP = 32;
+    static constexpr std::uint32_t NO_SPILL = UINT32_MAX;
+
+    NpcType attacker_type = NpcType::Toad;
+    NpcType defender_type = NpcType::Toad;
+    int x = 0;
+    int y = 0;
+    char attacker_name[NAME_CAP] = {};
+    char defender_name[NAME_CAP] = {};
+    std::uint32_t attacker_spill = NO_SPILL;
+    std::uint32_t defender_spill = NO_SPILL;
+};
+
+// onFight только кладет запись в кольцо, форматирует и пишет фоновый поток
+// большими пачками; в деструкторе все накопленное дописывается в файл
+class AsyncFileObserver : public IFFightObserver {
+private:
+    std::ofstream logfile;
+    AsyncLogConfig config;
+    BoundedQueue<FightRecord> records;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool wake_requested = false;
+    bool stopping = false;
+
+    // длинные имена редки, поэтому обычный мьютекс; запись кладется в кольцо после имени
+    std::mutex spill_mutex;
+    std::unordered_map<std::uint32_t, std::string> spilled_names;
+    std::uint32_t next_spill = 0;
+
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> written{0};
+    std::thread writer;
+
+    std::uint32_t storeName(std::string_view name, char (&out)[FightRecord::NAME_CAP]);
+    void appendName(std::string& batch, const char* name, std::uint32_t spill);
+    void releaseSpills(const FightRecord& record);
+    void format(const FightRecord& record, std::string& batch);
+    void requestWake();
+    void writerLoop();
+    std::size_t drainTo(std::string& batch);
+
+public:
+    explicit AsyncFileObserver(const std::string& filename = "logs_of_battle.txt", AsyncLogConfig config = {});
+    ~AsyncFileObserver();
+
+    AsyncFileObserver(const AsyncFileObserver&) = delete;
+    AsyncFileObserver& operator=(const AsyncFileObserver&) = delete;
+
+    void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override;
+    void onFightEvent(const FightEvent& event) override;
+
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    std::uint64_t writtenCount() const { return written.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// ограниченная lock-free очередь (кольцо Вьюкова): много производителей,
+// один или несколько потребителей; ожидание через std::atomic::wait без опроса
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos{0};
+
+    // счетчики-сигналы для ожидания: растут на каждом push/pop
+    alignas(CACHE_LINE) std::atomic<std::uint32_t> items_signal{0};
+    std::atomic<std::uint32_t> space_signal{0};
+    std::atomic<bool> closed{false};
+    std::atomic<std::uint64_t> producer_stalls{0};
+
+public:
+    // емкость округляется вверх до степени двойки
+    explicit BoundedQueue(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+
+        cells = std::make_unique<Cell[]>(size);
+        mask = size - 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool tryPush(const T& value) {
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    items_signal.fetch_add(1, std::memory_order_release);
+                    items_signal.notify_one();
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // полна
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    space_signal.fetch_add(1, std::memory_order_release);
+                    space_signal.notify_all();
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // пуста
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // ждет места; false, если очередь закрыта
+    bool push(const T& value) {
+        bool stalled = false;
+        for (;;) {
+            if (closed.load(std::memory_order_acquire)) return false;
+            std::uint32_t seen = space_signal.load(std::memory_order_acquire);
+            if (tryPush(value)) return true;
+            if (!stalled) {
+                producer_stalls.fetch_add(1, std::memory_order_relaxed);
+                stalled = true;
+            }
+            space_signal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    // ждет элемент; false, если очередь закрыта и пуста
+    bool pop(T& out) {
+        for (;;) {
+            std::uint32_t seen = items_signal.load(std::memory_order_acquire);
+            if (tryPop(out)) return true;
+            if (closed.load(std::memory_order_acquire)) return tryPop(out);
+            items_signal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    // будит всех ждущих; оставшиеся элементы еще можно забрать
+    void close() {
+        closed.store(true, std::memory_order_release);
+        items_signal.fetch_add(1, std::memory_order_release);
+        space_signal.fetch_add(1, std::memory_order_release);
+        items_signal.notify_all();
+        space_signal.notify_all();
+    }
+
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return mask + 1; }
+
+    // приблизительная глубина (точная, когда очередь не меняется)
+    std::size_t depth() const {
+        std::size_t head = dequeue_pos.load(std::memory_order_relaxed);
+        std::size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    // сколько раз производитель упирался в полную очередь
+    std::uint64_t producerStalls() const { return producer_stalls.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "grid.h"
+#include "world.h"
+
+// максимальная поддерживаемая дистанция убийства: разности координат
+// обрезаются до этого значения, чтобы квадраты помещались в int32
+constexpr int MAX_KILL_DIST = 32766;
+
+// размер блока кандидатов для одного вызова ядра (биты маски)
+constexpr std::size_t KILL_BLOCK = 32;
+
+// бит i установлен, если кандидат i в радиусе убийства:
+// by_self - в радиусе проверяемого нпс, by_other - нпс в радиусе кандидата
+struct KillMasks {
+    std::uint32_t by_self = 0;
+    std::uint32_t by_other = 0;
+};
+
+// один нпс против блока из n <= KILL_BLOCK кандидатов, сравнение квадратов без sqrt
+// (AVX2/SSE4.1 выбираются при запуске, иначе скалярный вариант)
+KillMasks killRangeMasks(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n);
+KillMasks killRangeMasksScalar(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n);
+const char* killRangeKernelName();
+
+// бой, найденный на тике tick
+struct FightTask {
+    World::Id attacker;
+    World::Id defender;
+    std::uint32_t tick;
+};
+
+// буферы для detectCell, переиспользуются между вызовами
+struct DetectScratch {
+    std::vector<World::Id> ids;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> kills;
+};
+
+// бои между нпс ячейки и ее соседями "вперед"
+void detectCell(const World& world, const std::vector<SpatialGrid::Id>& cell,
+                const std::vector<SpatialGrid::Id>* const* neighbors, std::size_t neighbor_count,
+                std::uint32_t tick, DetectScratch& scratch, std::vector<FightTask>& out);
+
+// поиск боев по сетке (ячейки по возрастанию координат); при взаимной досягаемости атакующий выбирается
+// генератором на счетчике (тик, пара), а не порядком обхода
+void detectFights(const World& world, const SpatialGrid& grid, std::uint32_t tick, std::vector<FightTask>& out);
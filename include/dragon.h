@@ -1,20 +1,22 @@
 #pragma once
 
+#include <string_view>
+
 #include "npc.h"
-#include "fightVisitor.h"
 
-class Dragon : public NPC, public std::enable_shared_from_this<Dragon> {
+class Dragon : public NPC {
 public:
+    static constexpr NpcType TYPE = NpcType::Dragon;
+    static constexpr std::string_view NAME = "Dragon";
+    static constexpr char SYMBOL = 'D';
+    static constexpr int MOVE_DIST = 50;   // расстояние хода 50
+    static constexpr int KILL_DIST = 30;   // расстояние убийства 30
+
+    // Дракон побеждает только рыцаря, жабе проигрывает, с драконом ничья
+    static constexpr bool beats(NpcType other) { return other == NpcType::Knight; }
+
     Dragon(const std::string& name, int x, int y);
     
-    bool accept(const std::shared_ptr<FightVisitor>& attacker) override;
-    
-    bool fight(const std::shared_ptr<Toad>& other) override;
-    bool fight(const std::shared_ptr<Dragon>& other) override;
-    bool fight(const std::shared_ptr<Knight>& other) override;
-    
-    int getMoveDist() const override { return 50; }   // расстояние хода 50
-    int getKillDist() const override { return 30; }   // расстояние убийства 30
-
-    std::string getType() const override { return "Dragon"; }
-};
\ No newline at end of file
+    int getMoveDist() const override { return MOVE_DIST; }
+    int getKillDist() const override { return KILL_DIST; }
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "observer.h"
+#include "registry.h"
+
+// двоичный журнал боев: заголовок файла, затем блоки [EventBlockHeader][записи].
+// Файл только дописывается; заголовок блока - индекс: диапазон тиков и убийства по видам,
+// поэтому запросы по окну тиков читают записи лишь у блоков на его границах.
+// Каждый запуск открывает сессию блоком-меткой без записей: тики и uid начинаются
+// заново, поэтому запросы идут по одной сессии. Порядок байт - little-endian
+
+// одна запись фиксированного размера
+struct EventRecord {
+    std::uint32_t tick;
+    std::uint32_t attacker;  // World::Uid, NO_NPC_ID - неизвестен
+    std::uint32_t defender;
+    std::int32_t x;          // место боя - координаты защищающегося, как в текстовом журнале
+    std::int32_t y;
+    std::uint8_t attacker_type;
+    std::uint8_t defender_type;
+    std::uint8_t success;    // FightEvent::success: атакующий убивает по таблице
+    std::uint8_t killed;     // FightEvent::killed: защищающийся убит после броска
+};
+
+constexpr std::size_t EVENT_LOG_MAX_KINDS = 8;
+
+struct EventLogHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t block_header_size;
+    std::uint32_t block_records;  // записей в полном блоке; последний блок сессии может быть короче
+    std::uint64_t reserved;
+};
+
+struct EventBlockHeader {
+    std::uint32_t magic;
+    std::uint32_t count;
+    std::uint32_t min_tick;
+    std::uint32_t max_tick;
+    std::uint32_t kills[EVENT_LOG_MAX_KINDS];  // записи с killed по виду атакующего
+    std::uint64_t reserved[2];                 // у метки сессии: seed и время начала в мс
+};
+
+constexpr char EVENT_LOG_MAGIC[8] = {'N', 'P', 'C', 'E', 'V', 'L', 'O', 'G'};
+constexpr std::uint32_t EVENT_LOG_VERSION = 3;  // 2: поле killed вместо резерва, 3: метки сессий
+constexpr std::uint32_t EVENT_BLOCK_MAGIC = 0x4b4c4245;    // "EBLK"
+constexpr std::uint32_t EVENT_SESSION_MAGIC = 0x53455345;  // "ESES", count = 0
+constexpr std::uint32_t EVENT_BLOCK_RECORDS = 4096;
+
+// дописывает блоки в конец файла; runtime_error, если файл не открылся или это не журнал.
+// Открытие начинает сессию с этим seed. Обрезанный хвост прошлой сессии (падение
+// посреди блока) отрезается при открытии, иначе новые блоки легли бы за ним
+// и читатель до них не дошел бы
+class EventLogWriter {
+private:
+    std::FILE* file = nullptr;
+    std::vector<EventRecord> block;
+    std::uint64_t written = 0;
+    std::uint64_t dropped_bytes = 0;
+
+    // конец последнего целого блока, начиная с позиции сразу за заголовком файла
+    long completeEnd(long file_size);
+
+public:
+    explicit EventLogWriter(const std::string& path, std::uint64_t seed = 0);
+    ~EventLogWriter();
+
+    EventLogWriter(const EventLogWriter&) = delete;
+    EventLogWriter& operator=(const EventLogWriter&) = delete;
+
+    void append(const EventRecord& record);
+    // неполный блок уходит в файл как есть
+    void flush();
+
+    std::uint64_t writtenCount() const { return written; }
+    // сколько байт обрезанного хвоста отрезано при открытии
+    std::uint64_t droppedBytes() const { return dropped_bytes; }
+};
+
+// наблюдатель, пишущий каждый бой записью журнала
+class BinaryLogObserver : public IFFightObserver {
+private:
+    EventLogWriter writer;
+
+public:
+    explicit BinaryLogObserver(const std::string& path, std::uint64_t seed = 0) : writer(path, seed) {}
+
+    void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override;
+    void onFightEvent(const FightEvent& event) override;
+
+    void flush() { writer.flush(); }
+    std::uint64_t writtenCount() const { return writer.writtenCount(); }
+    std::uint64_t droppedBytes() const { return writer.droppedBytes(); }
+};
+
+// сессия журнала по ее метке и заголовкам блоков
+struct EventSession {
+    std::uint64_t seed = 0;
+    std::uint64_t start_ms = 0;  // мс от эпохи Unix
+    std::uint64_t blocks = 0;
+    std::uint64_t records = 0;
+    std::uint32_t first_tick = UINT32_MAX;
+    std::uint32_t last_tick = 0;
+};
+
+// последовательное чтение блоков одной сессии (по умолчанию последней); обрезанный хвост
+// (запись прервалась, а писатель еще не открывал файл заново) не читается
+class EventLogReader {
+private:
+    std::FILE* file = nullptr;
+    std::vector<EventRecord> buffer;
+    std::vector<EventSession> session_list;
+    std::size_t session = 0;
+    std::uint64_t bytes_read = 0;
+    bool truncated_tail = false;
+
+    // все блоки файла; fn получает номер сессии блока, метки не передаются
+    void scanAll(const std::function<bool(std::size_t, const EventBlockHeader&)>& want,
+                 const std::function<void(const EventBlockHeader&, const EventRecord*, std::size_t)>& fn);
+
+public:
+    explicit EventLogReader(const std::string& path);
+    ~EventLogReader();
+
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+
+    // сессии в порядке записи; список снят при открытии
+    const std::vector<EventSession>& sessions() const { return session_list; }
+    std::size_t selectedSession() const { return session; }
+    // out_of_range, если такой сессии нет
+    void selectSession(std::size_t index);
+
+    // блоки выбранной сессии: want(header) решает, нужны ли записи блока,
+    // fn(header, records, count) получает только нужные
+    void scan(const std::function<bool(const EventBlockHeader&)>& want,
+              const std::function<void(const EventBlockHeader&, const EventRecord*, std::size_t)>& fn);
+
+    std::uint64_t bytesRead() const { return bytes_read; }
+    bool truncated() const { return truncated_tail; }
+};
+
+// убийства по видам атакующего в окне тиков [from_tick, from_tick + window); окна отсчитываются от from
+struct KillWindow {
+    std::uint32_t from_tick;
+    std::array<std::uint64_t, NPC_KIND_COUNT> kills{};
+};
+
+// тики [from, to]; window = 0 - одно окно на весь диапазон. Окна без убийств пропускаются
+std::vector<KillWindow> killsPerSpecies(EventLogReader& reader, std::uint32_t from, std::uint32_t to,
+                                        std::uint32_t window);
+// все бои нпс с этим uid (и атаки, и защиты) в выбранной сессии в порядке записи
+std::vector<EventRecord> npcHistory(EventLogReader& reader, std::uint32_t id);
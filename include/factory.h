@@ -1,15 +1,27 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <vector>
 
 #include "npc.h"
+#include "npcType.h"
+#include "world.h"
 
-enum class NpcType {
-    Toad,
-    Dragon, 
-    Knight
+class ThreadPool;
+
+// ошибка разбора одной строки текстового формата (строки с 1)
+struct ImportError {
+    std::size_t line;
+    std::string message;
+};
+
+struct ImportResult {
+    std::size_t loaded = 0;
+    std::vector<ImportError> errors;
 };
 
 // создание + загрузка
@@ -21,4 +33,11 @@ public:
     static std::shared_ptr<NPC> create(std::istream& is);
     // в файл
     static void save(const std::shared_ptr<NPC>& npc, std::ostream& os);
-};
\ No newline at end of file
+
+    // весь мир целиком: по строке "Type name x y" на нпс; пустые строки пропускаются,
+    // ошибочные не загружаются и попадают в errors. С пулом куски разбираются параллельно
+    static ImportResult load(std::string_view text, World& world, ThreadPool* pool = nullptr);
+    static ImportResult load(std::istream& is, World& world, ThreadPool* pool = nullptr);
+    // живые нпс мира в том же формате, большими блоками
+    static void save(const World& world, std::ostream& os);
+};
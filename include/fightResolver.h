@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "detect.h"
+#include "observer.h"
+#include "threadPool.h"
+#include "world.h"
+
+// фаза боев в пуле с тем же результатом, что у resolveFights.
+// Пачка задачи = 1 + последняя пачка любого из ее участников: в одной пачке нет общих нпс,
+// а бои каждого нпс идут в исходном порядке. Пачки разбираются по очереди, задачи пачки -
+// параллельно; события наблюдателю выдаются после, в порядке задач
+class FightResolver {
+public:
+    // пачки меньше этого разбираются в вызывающем потоке
+    static constexpr std::size_t MIN_PARALLEL_BATCH = 256;
+    // задач на одну работу пула
+    static constexpr std::size_t CHUNK = 64;
+
+    explicit FightResolver(ThreadPool& pool) : pool(pool) {}
+
+    // задачи одного тика; возвращает число убитых. В пуле из одного потока - просто resolveFights
+    std::size_t resolve(World& world, const std::vector<FightTask>& tasks,
+                        const std::shared_ptr<IFFightObserver>& observer);
+
+    // число пачек последнего resolve (0, если он шел без пачек)
+    std::size_t batchCount() const { return batch_starts.empty() ? 0 : batch_starts.size() - 1; }
+
+private:
+    enum Outcome : std::uint8_t { Skipped, Fought, Killed };
+
+    ThreadPool& pool;
+    std::vector<std::uint32_t> last_batch;    // по id мира, 0 - нпс еще не встречался
+    std::vector<std::uint32_t> batch_of;      // по задачам
+    std::vector<std::uint32_t> batch_starts;  // границы пачек в order
+    std::vector<std::uint32_t> order;         // индексы задач, сгруппированные по пачкам
+    std::vector<std::uint8_t> outcomes;       // по задачам
+
+    void split(const std::vector<FightTask>& tasks, std::size_t world_size);
+    void resolveRange(World& world, const std::vector<FightTask>& tasks, std::size_t begin, std::size_t end);
+};
@@ -1,15 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include "npc.h"
 #include "observer.h"
+#include "world.h"
 
-class Toad;
-class Dragon;
-class Knight;
-
-// бой
+// бой: исход берется из таблицы FIGHT_OUTCOMES (registry.h)
 class FightVisitor {
 private:
     std::shared_ptr<NPC> attacker;
@@ -18,10 +16,23 @@ private:
 public:
     FightVisitor(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<IFFightObserver>& observer = nullptr);
     
-    // перегружены для каждого типа нпс
-    bool visit(const std::shared_ptr<Toad>& defender);
-    bool visit(const std::shared_ptr<Dragon>& defender);
-    bool visit(const std::shared_ptr<Knight>& defender);
+    bool visit(const std::shared_ptr<NPC>& defender);
 
     std::shared_ptr<NPC> getAttacker() const { return attacker; }
-};
\ No newline at end of file
+};
+
+
+// бой по id мира: визитор живет на стеке и переиспользуется между боями,
+// фасады NPC не создаются, наблюдатель получает FightEvent
+class WorldFightVisitor {
+private:
+    const World& world;
+    IFFightObserver* observer;
+
+public:
+    explicit WorldFightVisitor(const World& world, IFFightObserver* observer = nullptr)
+        : world(world), observer(observer) {}
+
+    // tick и killed (итог броска, если бой уже разобран) попадают в событие наблюдателя
+    bool visit(World::Id attacker, World::Id defender, std::uint32_t tick = 0, bool killed = false) const;
+};
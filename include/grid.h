@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// пространственная сетка (хэш ячеек) для поиска соседей
+// размер ячейки >= максимальной дистанции убийства, поэтому пары ищутся только в соседних ячейках.
+// Хранятся только непустые ячейки, поэтому память не зависит от размеров карты
+class SpatialGrid {
+public:
+    using Id = std::uint32_t;
+
+    struct CellRef {
+        int cx;
+        int cy;
+        const std::vector<Id>* ids;
+    };
+
+    explicit SpatialGrid(int cell_size);
+
+    void insert(Id id, int x, int y);
+    void remove(Id id, int x, int y);
+    // перемещение, ячейка меняется только при пересечении ее границы
+    void move(Id id, int old_x, int old_y, int new_x, int new_y);
+    // нпс в точке (x, y) сменил id (слот мира переехал), место в ячейке то же
+    void rename(Id from, Id to, int x, int y);
+    // один проход по ячейкам: убирает все id, для которых drop(id), порядок остальных сохраняется;
+    // убранные дописываются в removed
+    template <typename Pred>
+    void removeIf(Pred&& drop, std::vector<Id>& removed);
+    void clear();
+
+    int getCellSize() const { return cell_size; }
+    bool sameCell(int x0, int y0, int x1, int y1) const {
+        return cellCoord(x0) == cellCoord(x1) && cellCoord(y0) == cellCoord(y1);
+    }
+    std::size_t size() const { return count; }
+    std::size_t cellCount() const { return live_cells; }
+
+    // непустые ячейки по возрастанию (cx, cy): соседние по x ячейки идут подряд,
+    // и порядок обхода не зависит от хэш-таблицы
+    void sortedCells(std::vector<CellRef>& out) const;
+    // соседи "вперед" (до 4 штук), каждая пара ячеек принадлежит ровно одной из них
+    std::size_t forwardNeighbors(int cx, int cy, const std::vector<Id>* (&out)[4]) const;
+
+    // каждая ячейка вместе с соседями "вперед" (до 4 штук):
+    // fn(const std::vector<Id>& cell, const std::vector<Id>* const* neighbors, std::size_t neighbor_count)
+    template <typename Fn>
+    void forEachCell(Fn&& fn) const;
+
+    // все пары из одной или соседних ячеек, каждая ровно один раз
+    template <typename Fn>
+    void forEachCandidatePair(Fn&& fn) const;
+
+private:
+    using Key = std::uint64_t;
+
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Cell {
+        int cx;
+        int cy;
+        std::vector<Id> ids;  // пустая ячейка лежит в free_slots и сохраняет емкость
+    };
+
+    int cell_size;
+    std::size_t count = 0;
+    std::size_t live_cells = 0;
+    std::vector<Cell> slots;
+    std::vector<std::uint32_t> free_slots;
+
+    // открытая адресация с линейным пробированием: ключ ячейки -> индекс в slots
+    std::vector<Key> table_keys;
+    std::vector<std::uint32_t> table_slots;  // NO_SLOT - пусто
+    std::size_t table_mask = 0;
+
+    int cellCoord(int v) const;
+    static Key makeKey(int cx, int cy);
+    std::size_t home(Key key) const;
+    std::uint32_t findSlot(Key key) const;
+    std::uint32_t findOrAddSlot(int cx, int cy);
+    void eraseKey(Key key);
+    void growTable();
+    static int keyX(Key key) { return static_cast<std::int32_t>(key >> 32); }
+    static int keyY(Key key) { return static_cast<std::int32_t>(key & 0xffffffffu); }
+};
+
+template <typename Pred>
+void SpatialGrid::removeIf(Pred&& drop, std::vector<Id>& removed) {
+    for (std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+        auto& ids = slots[slot].ids;
+        if (ids.empty()) continue;
+
+        std::size_t kept = 0;
+        for (Id id : ids) {
+            if (drop(id)) {
+                removed.push_back(id);
+            } else {
+                ids[kept++] = id;
+            }
+        }
+        if (kept == ids.size()) continue;
+
+        count -= ids.size() - kept;
+        ids.resize(kept);
+        if (ids.empty()) {
+            eraseKey(makeKey(slots[slot].cx, slots[slot].cy));
+            free_slots.push_back(slot);
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialGrid::forEachCell(Fn&& fn) const {
+    for (const auto& cell : slots) {
+        if (cell.ids.empty()) continue;
+        const std::vector<Id>* neighbors[4];
+        std::size_t neighbor_count = forwardNeighbors(cell.cx, cell.cy, neighbors);
+        fn(cell.ids, neighbors, neighbor_count);
+    }
+}
+
+template <typename Fn>
+void SpatialGrid::forEachCandidatePair(Fn&& fn) const {
+    forEachCell([&](const std::vector<Id>& ids, const std::vector<Id>* const* neighbors, std::size_t neighbor_count) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            for (std::size_t j = i + 1; j < ids.size(); ++j) {
+                fn(ids[i], ids[j]);
+            }
+        }
+        for (std::size_t n = 0; n < neighbor_count; ++n) {
+            for (Id a : ids) {
+                for (Id b : *neighbors[n]) {
+                    fn(a, b);
+                }
+            }
+        }
+    });
+}
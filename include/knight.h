@@ -1,20 +1,22 @@
 #pragma once
 
+#include <string_view>
+
 #include "npc.h"
-#include "fightVisitor.h"
 
-class Knight : public NPC, public std::enable_shared_from_this<Knight> {
+class Knight : public NPC {
 public:
+    static constexpr NpcType TYPE = NpcType::Knight;
+    static constexpr std::string_view NAME = "Knight";
+    static constexpr char SYMBOL = 'K';
+    static constexpr int MOVE_DIST = 30;
+    static constexpr int KILL_DIST = 10;
+
+    // Рыцарь побеждает только дракона, жабе проигрывает, с рыцарем ничья
+    static constexpr bool beats(NpcType other) { return other == NpcType::Dragon; }
+
     Knight(const std::string& name, int x, int y);
     
-    bool accept(const std::shared_ptr<FightVisitor>& attacker) override;
-    
-    bool fight(const std::shared_ptr<Toad>& other) override;
-    bool fight(const std::shared_ptr<Dragon>& other) override;
-    bool fight(const std::shared_ptr<Knight>& other) override;
-    
-    int getMoveDist() const override { return 30; }  
-    int getKillDist() const override { return 10; }   
-
-    std::string getType() const override { return "Knight"; }
-};
\ No newline at end of file
+    int getMoveDist() const override { return MOVE_DIST; }
+    int getKillDist() const override { return KILL_DIST; }
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// метрики процесса: запись - только атомарные операции без блокировок,
+// блокировка берется лишь при регистрации и выгрузке
+
+class Counter {
+public:
+    void add(std::uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+class Gauge {
+public:
+    void set(std::int64_t v) { value_.store(v, std::memory_order_relaxed); }
+    void add(std::int64_t n) { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+// гистограмма в духе HDR: значения до 64 точные, дальше каждая октава делится
+// на SUB_BUCKETS корзин, относительная ошибка не больше 1/SUB_BUCKETS
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKETS = 2 * SUB_BUCKETS + (64 - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+    void record(std::uint64_t value);
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    // верхняя граница корзины, в которую попал q-квантиль (не больше max)
+    std::uint64_t quantile(double q) const;
+
+    static std::size_t bucketOf(std::uint64_t value);
+    static std::uint64_t bucketUpper(std::size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// необязательная метка метрики: phase="move", species="Dragon"
+struct MetricLabel {
+    std::string_view key;
+    std::string_view value;
+};
+
+class MetricsRegistry {
+public:
+    // одно и то же имя с меткой возвращает тот же объект; ссылки живут вместе с реестром.
+    // Имя, уже занятое метрикой другого вида, - std::invalid_argument
+    Counter& counter(std::string_view name, std::string_view help, MetricLabel label = {});
+    Gauge& gauge(std::string_view name, std::string_view help, MetricLabel label = {});
+    Histogram& histogram(std::string_view name, std::string_view help, MetricLabel label = {});
+
+    // у счетчиков per_second - скорость с прошлой выгрузки JSON за elapsed_seconds
+    void writeJson(std::ostream& out, double elapsed_seconds = 0);
+    // текстовый формат Prometheus; гистограммы - как summary с квантилями
+    void writePrometheus(std::ostream& out) const;
+
+private:
+    enum class Kind { Counter, Gauge, Histogram };
+
+    struct Entry {
+        Kind kind;
+        std::string name;
+        std::string help;
+        std::string label_key;
+        std::string label_value;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+        std::uint64_t last_value = 0;  // значение счетчика на прошлой выгрузке JSON
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;
+
+    Entry& find(Kind kind, std::string_view name, std::string_view help, MetricLabel label);
+};
+
+// реестр запуска
+MetricsRegistry& metrics();
+
+enum class MetricsFormat { Json, Prometheus };
+
+// фоновая выгрузка реестра в файл раз в interval; файл заменяется целиком
+// (запись во временный и rename), в деструкторе - последняя выгрузка
+class MetricsDumper {
+public:
+    MetricsDumper(MetricsRegistry& registry, std::string path, std::chrono::milliseconds interval,
+                  MetricsFormat format);
+    ~MetricsDumper();
+
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    // выгрузить сейчас; false - файл не записан
+    bool dump();
+
+    // .json - JSON, иначе Prometheus
+    static MetricsFormat formatFor(std::string_view path);
+
+private:
+    MetricsRegistry& registry;
+    std::string path;
+    std::chrono::milliseconds interval;
+    MetricsFormat format;
+    std::mutex dump_mutex;
+    std::chrono::steady_clock::time_point last_dump;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread worker;
+
+    void loop();
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// имена нпс одним непрерывным буфером: 32-битный id -> смещение, без std::string на имя.
+// string_view действителен до следующего добавления или compact (буфер может переехать)
+class NameTable {
+public:
+    using NameId = std::uint32_t;
+
+    NameId add(std::string_view name);
+    // n имен, упакованных подряд: имя i - [offsets[i], offsets[i + 1]) в chars;
+    // возвращает id первого
+    NameId addPacked(std::size_t n, const char* chars, const std::uint32_t* offsets);
+
+    std::string_view get(NameId id) const {
+        return {chars.data() + offsets[id], offsets[id + 1] - offsets[id]};
+    }
+
+    std::size_t size() const { return offsets.size() - 1; }
+    std::size_t bytes() const { return chars.size(); }
+    void reserve(std::size_t names, std::size_t bytes);
+
+    // оставляет только имена из ids, в их порядке, и переписывает ids на новые номера;
+    // имена, на которые никто не ссылается, выбрасываются
+    void compact(std::vector<NameId>& ids);
+
+private:
+    std::vector<char> chars;
+    std::vector<std::uint32_t> offsets{0};
+
+    void checkCapacity(std::size_t extra) const;
+};
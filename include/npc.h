@@ -2,32 +2,33 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+
+#include "npcType.h"
+#include "rng.h"
 
 class FightVisitor;
 class IFFightObserver;
 
-// Предварительные объявления для ваших типов NPC
-class Toad;
-class Dragon;
-class Knight;
-
-class NPC {
+class NPC : public std::enable_shared_from_this<NPC> {
 protected:
+    NpcType type;
     std::string name;
     int x, y;
     bool alive;
 
 public:
-    NPC(const std::string& name, int x, int y);
+    NPC(NpcType type, const std::string& name, int x, int y);
     virtual ~NPC() = default;
 
-    virtual bool accept(const std::shared_ptr<FightVisitor>& attacker) = 0;
-    
-    virtual bool fight(const std::shared_ptr<Toad>& other) = 0;
-    virtual bool fight(const std::shared_ptr<Dragon>& other) = 0;
-    virtual bool fight(const std::shared_ptr<Knight>& other) = 0;
+    // исход боя решает таблица из registry.h, визитор только передает защищающегося
+    bool accept(const std::shared_ptr<FightVisitor>& attacker);
 
-    std::string getName() const { return name; }
+    NpcType getTypeTag() const { return type; }
+    // имя вида из реестра, без выделения памяти
+    std::string_view getType() const;
+    char getSymbol() const;
+    const std::string& getName() const { return name; }
     int getX() const { return x; }
     int getY() const { return y; }
     bool isAlive() const { return alive; }
@@ -35,12 +36,19 @@ public:
 
     double distance(const std::shared_ptr<NPC>& other) const;
 
-    virtual std::string getType() const = 0;
     // бросок
     std::pair<int, int> rollDice() const;
+    std::pair<int, int> rollDice(CounterRng& rng) const;
     virtual int getMoveDist() const = 0;
     virtual int getKillDist() const = 0;
     void moveRandom();  // Движение NPC
+    void moveRandom(CounterRng& rng);
 };
 
-using NPCPtr = std::shared_ptr<NPC>;
\ No newline at end of file
+// бросок атаки и защиты (1-6 каждый)
+std::pair<int, int> rollDice(CounterRng& rng);
+
+// случайный шаг на move_dist по каждой оси, за границу карты (worldConfig) не выходит
+void randomStep(int& x, int& y, int move_dist, CounterRng& rng);
+
+using NPCPtr = std::shared_ptr<NPC>;
@@ -0,0 +1,8 @@
+#pragma once
+
+// виды нпс; порядок совпадает со списком NpcKinds в registry.h
+enum class NpcType {
+    Toad,
+    Dragon, 
+    Knight
+};
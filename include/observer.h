@@ -1,21 +1,53 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <iostream>
 #include <fstream>
+#include <string_view>
+#include <vector>
 
 #include "npc.h"
+#include "npcType.h"
+
+// id нпс неизвестен (событие собрано из фасадов)
+constexpr std::uint32_t NO_NPC_ID = UINT32_MAX;
+
+// участник боя без объекта NPC: поля читаются прямо из мира
+struct FighterRef {
+    NpcType type;
+    std::string_view name;
+    int x;
+    int y;
+    std::uint32_t id = NO_NPC_ID;  // World::Uid: не меняется, пока нпс жив
+};
+
+// бой для наблюдателя; ссылки действительны только во время вызова
+struct FightEvent {
+    FighterRef attacker;
+    FighterRef defender;
+    bool success;            // атакующий убивает по таблице видов
+    std::uint32_t tick = 0;  // 0 - вне тиков
+    bool killed = false;     // защищающийся убит после броска костей; false, если исход не известен
+};
+
+// событие из фасадов для старого пути onFight; ссылается на имена нпс.
+// У фасадов нет броска костей, поэтому их success и есть исход: killed = success
+FightEvent makeEvent(const NPC& attacker, const NPC& defender, bool success);
 
 // печать на экран/файл
 class IFFightObserver {
 public:
     virtual ~IFFightObserver() = default;
     virtual void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) = 0;
+    // путь боев без выделений памяти; по умолчанию собирает фасады и зовет onFight с killed
+    virtual void onFightEvent(const FightEvent& event);
 };
 
 class TextObserver : public IFFightObserver {
 public:
     void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override;
+    void onFightEvent(const FightEvent& event) override;
 };
 
 class FileObserver : public IFFightObserver {
@@ -27,4 +59,17 @@ public:
     ~FileObserver();
     
     void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override;
-};
\ No newline at end of file
+    void onFightEvent(const FightEvent& event) override;
+};
+
+// рассылка события нескольким наблюдателям по порядку добавления
+class ObserverGroup : public IFFightObserver {
+private:
+    std::vector<std::shared_ptr<IFFightObserver>> observers;
+
+public:
+    void add(const std::shared_ptr<IFFightObserver>& observer) { observers.push_back(observer); }
+
+    void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override;
+    void onFightEvent(const FightEvent& event) override;
+};
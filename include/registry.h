@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "npcType.h"
+#include "toad.h"
+#include "dragon.h"
+#include "knight.h"
+
+template <typename... Ts>
+struct TypeList {
+    static constexpr std::size_t size = sizeof...(Ts);
+};
+
+// все виды нпс, порядок совпадает с NpcType;
+// новый вид = класс с TYPE/NAME/SYMBOL/MOVE_DIST/KILL_DIST/beats() + строчка здесь
+using NpcKinds = TypeList<Toad, Dragon, Knight>;
+
+constexpr std::size_t NPC_KIND_COUNT = NpcKinds::size;
+
+struct KindInfo {
+    std::string_view name;
+    char symbol;
+    int move_dist;
+    int kill_dist;
+};
+
+using FightTable = std::array<std::array<bool, NPC_KIND_COUNT>, NPC_KIND_COUNT>;
+
+namespace registry_detail {
+
+template <typename... Ts>
+constexpr bool orderMatches(TypeList<Ts...>) {
+    std::size_t i = 0;
+    return ((static_cast<std::size_t>(Ts::TYPE) == i++) && ...);
+}
+
+template <typename... Ts>
+constexpr std::array<KindInfo, sizeof...(Ts)> makeInfo(TypeList<Ts...>) {
+    return {KindInfo{Ts::NAME, Ts::SYMBOL, Ts::MOVE_DIST, Ts::KILL_DIST}...};
+}
+
+// строка a таблицы - кого побеждает вид a
+template <typename... Ts>
+constexpr FightTable makeOutcomes(TypeList<Ts...>) {
+    constexpr bool (*beats[])(NpcType) = {&Ts::beats...};
+    FightTable table{};
+    for (std::size_t a = 0; a < sizeof...(Ts); ++a) {
+        for (std::size_t d = 0; d < sizeof...(Ts); ++d) {
+            table[a][d] = beats[a](static_cast<NpcType>(d));
+        }
+    }
+    return table;
+}
+
+template <typename... Ts>
+std::shared_ptr<NPC> make(TypeList<Ts...>, NpcType type, const std::string& name, int x, int y) {
+    std::shared_ptr<NPC> result;
+    ((Ts::TYPE == type ? (result = std::make_shared<Ts>(name, x, y), true) : false) || ...);
+    return result;
+}
+
+template <typename Alloc, typename... Ts>
+std::shared_ptr<NPC> allocate(TypeList<Ts...>, const Alloc& alloc, NpcType type, const std::string& name, int x, int y) {
+    std::shared_ptr<NPC> result;
+    ((Ts::TYPE == type ? (result = std::allocate_shared<Ts>(alloc, name, x, y), true) : false) || ...);
+    return result;
+}
+
+}
+
+static_assert(registry_detail::orderMatches(NpcKinds{}), "NpcKinds order must match NpcType");
+
+constexpr std::array<KindInfo, NPC_KIND_COUNT> KIND_INFO = registry_detail::makeInfo(NpcKinds{});
+constexpr FightTable FIGHT_OUTCOMES = registry_detail::makeOutcomes(NpcKinds{});
+
+constexpr int MAX_KIND_KILL_DIST = [] {
+    int result = 0;
+    for (const auto& info : KIND_INFO) {
+        result = info.kill_dist > result ? info.kill_dist : result;
+    }
+    return result;
+}();
+
+constexpr bool isValidType(NpcType type) {
+    return static_cast<std::size_t>(type) < NPC_KIND_COUNT;
+}
+
+constexpr const KindInfo& kindInfo(NpcType type) {
+    return KIND_INFO[static_cast<std::size_t>(type)];
+}
+
+// может ли атакующий убить защищающегося - одна выборка из таблицы
+constexpr bool canKill(NpcType attacker, NpcType defender) {
+    return FIGHT_OUTCOMES[static_cast<std::size_t>(attacker)][static_cast<std::size_t>(defender)];
+}
+
+constexpr std::string_view typeName(NpcType type) { return kindInfo(type).name; }
+constexpr char typeSymbol(NpcType type) { return kindInfo(type).symbol; }
+
+constexpr std::optional<NpcType> parseType(std::string_view name) {
+    for (std::size_t i = 0; i < NPC_KIND_COUNT; ++i) {
+        if (KIND_INFO[i].name == name) return static_cast<NpcType>(i);
+    }
+    return std::nullopt;
+}
+
+// nullptr для неизвестного вида
+inline std::shared_ptr<NPC> makeNpc(NpcType type, const std::string& name, int x, int y) {
+    return registry_detail::make(NpcKinds{}, type, name, x, y);
+}
+
+// то же через аллокатор (объект и блок управления одним куском из пула)
+template <typename Alloc>
+std::shared_ptr<NPC> allocateNpc(const Alloc& alloc, NpcType type, const std::string& name, int x, int y) {
+    return registry_detail::allocate(NpcKinds{}, alloc, type, name, x, y);
+}
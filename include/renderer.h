@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// отрисовка карты в терминал. Кадр целиком собирается в один заранее выделенный буфер.
+// В ANSI-режиме строки статуса и карта стоят на месте вверху экрана, и в буфер попадают
+// только клетки, изменившиеся с прошлого кадра. Строки журнала прокручиваются в области
+// под картой. Без ANSI (вывод в файл) каждый кадр печатается целиком, как раньше
+class TerminalRenderer {
+public:
+    static constexpr int STATUS_LINES = 4;
+
+    // terminal_rows - высота терминала, нужна для области прокрутки журнала
+    TerminalRenderer(int width, int height, bool ansi, int terminal_rows = 50);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // новый кадр: все клетки пустые ('.')
+    void beginFrame();
+    void plot(int col, int row, char symbol) { current[static_cast<std::size_t>(row) * width + col] = symbol; }
+    // status - до STATUS_LINES строк через '\n'; результат действителен до следующего кадра
+    std::string_view finishFrame(std::string_view status);
+
+    // следующий кадр рисуется целиком (экран мог испортиться)
+    void invalidate() { full_redraw = true; }
+    // вернуть терминал в обычный режим после последнего кадра
+    std::string_view close();
+
+    std::size_t changedCells() const { return changed; }
+
+private:
+    int width;
+    int height;
+    bool ansi;
+    int terminal_rows;
+
+    std::vector<char> current;
+    std::vector<char> previous;
+    std::string buffer;
+    bool full_redraw = true;
+    std::size_t changed = 0;
+
+    int mapTop() const { return STATUS_LINES + 2; }  // статус, пустая строка, карта
+    int logTop() const { return mapTop() + height + 1; }
+
+    void moveTo(int row, int col);
+    void appendInt(int value);
+    void renderPlain(std::string_view status);
+    void renderAnsi(std::string_view status);
+};
+
+// пишет весь буфер в stdout (обычно одним системным вызовом)
+void writeFrame(std::string_view frame);
+// stdout - терминал, можно пользоваться ANSI-последовательностями
+bool stdoutIsTerminal();
+// высота терминала в строках или fallback, если ее не узнать
+int terminalRows(int fallback = 50);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// назначение случайных чисел; разные потоки событий не пересекаются
+enum class RngStream : std::uint32_t {
+    Spawn,
+    Move,
+    Dice,
+    TieBreak,
+    Local
+};
+
+// Philox4x32-10: блок из 4 слов - чистая функция от (счетчик, ключ)
+std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+// зерно запуска (--seed), общее для всех потоков
+void setRunSeed(std::uint64_t seed);
+std::uint64_t runSeed();
+
+// генератор на счетчике: результат зависит только от зерна, потока событий,
+// тика и участников, поэтому не зависит от числа потоков и порядка их работы
+class CounterRng {
+private:
+    std::array<std::uint32_t, 4> counter;
+    std::array<std::uint32_t, 2> key;
+    std::array<std::uint32_t, 4> block{};
+    unsigned used = 4;
+
+public:
+    CounterRng(std::uint64_t seed, RngStream stream, std::uint32_t tick, std::uint32_t a, std::uint32_t b = 0);
+
+    std::uint32_t next();
+    // равномерно в [0, n)
+    int below(int n) { return static_cast<int>((static_cast<std::uint64_t>(next()) * static_cast<std::uint32_t>(n)) >> 32); }
+};
+
+// генератор текущего потока для вызовов без явного тика (фасад NPC, тесты):
+// потокобезопасен, но воспроизводим только в пределах одного потока
+CounterRng& threadRng();
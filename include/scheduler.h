@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <vector>
+
+#include "metrics.h"
+#include "simulation.h"
+
+struct RunStats {
+    std::uint64_t ticks = 0;
+    std::uint64_t npc_updates = 0;  // ходы живых нпс
+    std::uint64_t fights = 0;
+    std::uint64_t kills = 0;
+    double seconds = 0;
+
+    double ticksPerSecond() const { return seconds > 0 ? ticks / seconds : 0; }
+    double updatesPerSecond() const { return seconds > 0 ? npc_updates / seconds : 0; }
+};
+
+// тик = явные фазы move -> detect -> resolve -> compact; следующий тик начинается только
+// после разбора боев предыдущего, поэтому запуск с одним зерном воспроизводим
+class TickScheduler {
+public:
+    // фаза боев: получает номер тика и его бои, возвращает число убитых
+    using Resolver = std::function<std::size_t(std::uint32_t, const std::vector<FightTask>&)>;
+
+    // world_mutex (если задан) берется на move и compact (уникально) и detect (разделяемо)
+    TickScheduler(Simulation& simulation, Resolver resolve, std::shared_mutex* world_mutex = nullptr);
+
+    // фиксированный шаг: тики не чаще одного за step, пока running
+    RunStats runFixed(std::chrono::milliseconds step, const std::atomic<bool>& running);
+    // безголовый режим: ticks тиков подряд без пауз
+    RunStats runHeadless(std::uint32_t ticks);
+
+    std::uint32_t lastTick() const { return tick; }
+
+private:
+    Simulation& simulation;
+    Resolver resolve;
+    std::shared_mutex* world_mutex;
+    std::uint32_t tick = 0;
+    std::vector<FightTask> fights;
+
+    // метрики реестра metrics(): время фаз, счетчики тиков, ходов и боев
+    Histogram& move_time;
+    Histogram& detect_time;
+    Histogram& resolve_time;
+    Histogram& compact_time;
+    Counter& ticks_total;
+    Counter& updates_total;
+    Counter& fights_total;
+    Counter& capped_ticks;
+    Gauge& alive;
+
+    void step(RunStats& stats);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "detect.h"
+#include "grid.h"
+#include "observer.h"
+#include "threadPool.h"
+#include "world.h"
+
+// фазы тика над миром: мир делится на тайлы - полосы соседних ячеек сетки,
+// которые обрабатываются параллельно в пуле
+class Simulation {
+public:
+    // число тайлов не зависит от числа потоков, поэтому порядок боев тоже
+    static constexpr std::size_t TILE_COUNT = 64;
+
+    Simulation(World& world, ThreadPool& pool);
+
+    // заново раскладывает живых нпс по сетке
+    void indexWorld();
+
+    // новый нпс между тиками; после compact свободных слотов нет, и он встает в конец
+    World::Id spawn(NpcType type, std::string_view name, int x, int y);
+
+    // движение: тайлы двигают своих нпс параллельно, смены ячеек применяются
+    // к сетке после барьера; в сетке только живые (см. compact), возвращает число сходивших
+    std::size_t move(std::uint32_t tick);
+
+    // поиск боев: пара ячеек на границе тайлов принадлежит ячейке с меньшими
+    // координатами, поэтому каждая пара находится ровно одним тайлом.
+    // Не больше fightLimit() боев: out - первые из полного списка, остальные пары
+    // не копятся и находятся заново на следующем тике, если еще в радиусе
+    void detect(std::uint32_t tick, std::vector<FightTask>& out);
+
+    // предел боев за тик; тайл бросает поиск, набрав его, поэтому память поиска
+    // не больше TILE_COUNT * (limit + бои одной ячейки)
+    void setFightLimit(std::size_t limit) { fight_limit = limit; }
+    std::size_t fightLimit() const { return fight_limit; }
+    // последний detect набрал предел (возможно, ровно столько боев и было)
+    bool lastDetectCapped() const { return detect_capped; }
+
+    // уборка после фазы боев: убитые там только помечены, здесь все они одним проходом
+    // уходят из сетки, а мир уплотняется (World::compact), id живых в сетке правятся;
+    // возвращает число убранных
+    std::size_t compact();
+
+    const SpatialGrid& getGrid() const { return grid; }
+
+private:
+    struct Relocation {
+        World::Id id;
+        int old_x, old_y;
+        int new_x, new_y;
+    };
+
+    World& world;
+    ThreadPool& pool;
+    SpatialGrid grid;
+
+    std::vector<SpatialGrid::CellRef> cells;
+    std::vector<std::vector<Relocation>> relocations;  // по тайлам
+    std::vector<std::size_t> moved_counts;              // по тайлам
+    std::vector<std::vector<FightTask>> found;          // по тайлам
+    std::vector<World::Id> removed;
+    std::vector<World::SlotMove> slot_moves;
+    std::size_t fight_limit = SIZE_MAX;
+    bool detect_capped = false;
+    std::vector<DetectScratch> scratch;                 // по тайлам
+
+    std::size_t tileBegin(std::size_t tile) const { return cells.size() * tile / TILE_COUNT; }
+    std::size_t tileEnd(std::size_t tile) const { return cells.size() * (tile + 1) / TILE_COUNT; }
+};
+
+// один бой: оба живы, исход по таблице, бросок кубиков по (тик, пара);
+// true - защищающийся убит
+bool resolveFight(World& world, const FightTask& task, const std::shared_ptr<IFFightObserver>& observer);
+
+// фаза боев: задачи строго по порядку, возвращает число убитых
+std::size_t resolveFights(World& world, const std::vector<FightTask>& tasks,
+                          const std::shared_ptr<IFFightObserver>& observer);
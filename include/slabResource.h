@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// ресурс памяти для мелких объектов одного-двух размеров (фасады NPC, блоки shared_ptr):
+// куски нарезаются из больших плит, освобожденные лежат в списке своего класса размера
+// и отдаются следующему запросу; память возвращается системе только в деструкторе.
+// Потокобезопасен (короткая спин-блокировка), большие запросы уходят в upstream
+class SlabResource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t MAX_BLOCK = 256;
+    static constexpr std::size_t SLAB_BYTES = 64 * 1024;
+
+    explicit SlabResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~SlabResource() override;
+
+    SlabResource(const SlabResource&) = delete;
+    SlabResource& operator=(const SlabResource&) = delete;
+
+    // сколько плит взято у upstream за все время
+    std::size_t slabCount() const { return slabs.size(); }
+
+private:
+    static constexpr std::size_t GRANULE = 16;
+    static constexpr std::size_t CLASS_COUNT = MAX_BLOCK / GRANULE;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::pmr::memory_resource* upstream;
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    FreeBlock* free_lists[CLASS_COUNT] = {};
+    std::vector<void*> slabs;
+    char* cursor = nullptr;  // свободный хвост текущей плиты
+    char* slab_end = nullptr;
+
+    void lock();
+    void unlock() { busy.clear(std::memory_order_release); }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
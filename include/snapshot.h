@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "world.h"
+
+// двоичный снимок мира: заголовок + столбцы (вид, жив, x, y, смещения имен, имена),
+// каждый столбец выровнен на 64 байта, порядок байт - little-endian
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t count;
+    std::uint64_t types_offset;
+    std::uint64_t alive_offset;
+    std::uint64_t xs_offset;
+    std::uint64_t ys_offset;
+    std::uint64_t name_offsets_offset;  // count + 1 значений uint32
+    std::uint64_t names_offset;
+    std::uint64_t names_size;
+};
+
+constexpr char SNAPSHOT_MAGIC[8] = {'N', 'P', 'C', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+// пишет снимок; runtime_error, если файл не открылся или имена не влезают в 4 ГБ.
+// Uid в снимок не попадают: загруженные нпс получают новые по порядку слотов
+void saveSnapshot(const World& world, const std::string& path);
+
+// снимок, отображенный в память только для чтения; данные читаются на месте
+class SnapshotView {
+private:
+    const char* data = nullptr;
+    std::size_t length = 0;
+    std::vector<char> fallback;  // если mmap недоступен
+    const SnapshotHeader* header = nullptr;
+
+    template <typename T>
+    const T* column(std::uint64_t offset) const { return reinterpret_cast<const T*>(data + offset); }
+    void validate();
+    void unmap();
+
+public:
+    // runtime_error, если файла нет или он поврежден
+    explicit SnapshotView(const std::string& path);
+    ~SnapshotView();
+
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    std::size_t size() const { return header->count; }
+    std::uint32_t version() const { return header->version; }
+
+    const std::uint8_t* types() const { return column<std::uint8_t>(header->types_offset); }
+    const std::uint8_t* alive() const { return column<std::uint8_t>(header->alive_offset); }
+    const std::int32_t* xs() const { return column<std::int32_t>(header->xs_offset); }
+    const std::int32_t* ys() const { return column<std::int32_t>(header->ys_offset); }
+    const std::uint32_t* nameOffsets() const { return column<std::uint32_t>(header->name_offsets_offset); }
+    const char* names() const { return column<char>(header->names_offset); }
+
+    NpcType getType(std::size_t i) const { return static_cast<NpcType>(types()[i]); }
+    std::string_view getName(std::size_t i) const {
+        const std::uint32_t* offsets = nameOffsets();
+        return {names() + offsets[i], offsets[i + 1] - offsets[i]};
+    }
+
+    // копирует столбцы в мир целиком
+    void appendTo(World& world) const;
+};
+
+// открыть снимок и добавить его в мир
+void loadSnapshot(const std::string& path, World& world);
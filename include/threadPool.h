@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// пул потоков с перехватом работы: у каждого потока своя очередь,
+// свободный поток забирает задачи из чужих очередей с другого конца
+class ThreadPool {
+public:
+    // workers - всего потоков вместе с вызывающим, 0 = по числу ядер
+    explicit ThreadPool(std::size_t workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return queues.size(); }
+
+    // fn(i) для i в [0, count); вызывающий поток тоже работает и ждет завершения всех.
+    // вызывается из одного потока-владельца; fn не должна бросать исключения
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // [0] - вызывающий поток
+    std::vector<std::thread> threads;
+
+    std::atomic<std::uint32_t> work_signal{0};
+    std::atomic<std::size_t> pending{0};
+    std::atomic<bool> stopping{false};
+
+    bool runOne(std::size_t self);
+    void workerLoop(std::size_t self);
+};
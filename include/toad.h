@@ -1,20 +1,22 @@
 #pragma once
 
+#include <string_view>
+
 #include "npc.h"
-#include "fightVisitor.h"
 
-class Toad : public NPC, public std::enable_shared_from_this<Toad> {
+class Toad : public NPC {
 public:
+    static constexpr NpcType TYPE = NpcType::Toad;
+    static constexpr std::string_view NAME = "Toad";
+    static constexpr char SYMBOL = 'T';
+    static constexpr int MOVE_DIST = 1;    // расстояние хода 1
+    static constexpr int KILL_DIST = 10;   // расстояние убийства 10
+
+    // Жаба побеждает всех
+    static constexpr bool beats(NpcType) { return true; }
+
     Toad(const std::string& name, int x, int y);
     
-    bool accept(const std::shared_ptr<FightVisitor>& attacker) override;
-    
-    bool fight(const std::shared_ptr<Toad>& other) override;
-    bool fight(const std::shared_ptr<Dragon>& other) override;
-    bool fight(const std::shared_ptr<Knight>& other) override;
-    
-    int getMoveDist() const override { return 1; }    // расстояние хода 1
-    int getKillDist() const override { return 10; }   // расстояние убийства 10
-
-    std::string getType() const override { return "Toad"; }
-};
\ No newline at end of file
+    int getMoveDist() const override { return MOVE_DIST; }
+    int getKillDist() const override { return KILL_DIST; }
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// трассировка в формате Chrome trace event (chrome://tracing, Perfetto).
+// Спаны пишутся в буфер своего потока; без LAB7_TRACING макросы ничего не стоят.
+// Имена и категории - строковые литералы: хранится только указатель
+
+// включить запись; прошлые спаны забываются, время отсчитывается от этого вызова
+void startTracing();
+void stopTracing();
+bool tracingEnabled();
+
+// наносекунды от startTracing
+std::uint64_t traceNow();
+void traceSpan(const char* name, const char* category, std::uint64_t start_ns, std::uint64_t end_ns);
+// имя текущего потока в трассе
+void traceThreadName(const std::string& name);
+
+// {"traceEvents": [...]}; спаны сверх лимита потока отбрасываются и считаются в dropped
+void writeTrace(std::ostream& out);
+bool writeTraceFile(const std::string& path);
+std::uint64_t traceSpanCount();
+std::uint64_t traceDroppedCount();
+
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category)
+        : name(name), category(category), start(tracingEnabled() ? traceNow() : NOT_STARTED) {}
+    ~TraceScope() {
+        if (start != NOT_STARTED) traceSpan(name, category, start, traceNow());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    static constexpr std::uint64_t NOT_STARTED = UINT64_MAX;
+
+    const char* name;
+    const char* category;
+    std::uint64_t start;
+};
+
+#define LAB7_TRACE_CONCAT_INNER(a, b) a##b
+#define LAB7_TRACE_CONCAT(a, b) LAB7_TRACE_CONCAT_INNER(a, b)
+
+#ifdef LAB7_TRACING
+// спан до конца текущей области видимости
+#define TRACE_SCOPE(name, category) ::TraceScope LAB7_TRACE_CONCAT(trace_scope_, __LINE__)(name, category)
+#else
+#define TRACE_SCOPE(name, category) static_cast<void>(0)
+#endif
+
+// захват блокировки; ожидание попадает в трассу отдельным спаном категории "lock"
+template <typename Lock>
+void lockTraced(Lock& lock, [[maybe_unused]] const char* name) {
+    TRACE_SCOPE(name, "lock");
+    lock.lock();
+}
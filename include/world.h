@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "npc.h"
+#include "nameTable.h"
+#include "npcType.h"
+#include "slabResource.h"
+
+// мир нпс в виде структуры массивов: горячие поля лежат подряд,
+// объекты NPC создаются только как фасад по запросу.
+// Id - номер слота, он меняется, когда compact переносит нпс в дыру; случайность
+// и журналы привязаны к Uid - постоянному номеру нпс в порядке появления в мире
+class World {
+public:
+    using Id = std::uint32_t;
+    using Uid = std::uint32_t;
+
+    // нпс переехал из слота from в слот to
+    struct SlotMove {
+        Id from;
+        Id to;
+    };
+
+    World();
+
+    Id add(const NPC& npc);
+    // без фасада NPC; координаты проверяет тот, кто их прочитал
+    Id add(NpcType type, std::string_view name, int x, int y, bool is_alive = true);
+    // пакетная вставка столбцов (снимок): имена упакованы подряд,
+    // имя i - [name_offsets[i], name_offsets[i + 1])
+    void append(std::size_t n, const std::uint8_t* types, const std::uint8_t* alive, const std::int32_t* xs,
+                const std::int32_t* ys, const char* names, const std::uint32_t* name_offsets);
+    void reserve(std::size_t n);
+    // байты имен в таблице (для оценки памяти), вместе с еще не убранными старыми
+    std::size_t nameBytes() const { return names.bytes(); }
+
+    // слот мертвого нпс, на который больше никто не ссылается (сетка, задачи боев),
+    // становится свободным; живые, уже свободные и несуществующие id пропускаются
+    void release(Id id);
+    // новый нпс в освобожденном слоте, если такой есть, иначе в конце
+    Id spawn(NpcType type, std::string_view name, int x, int y);
+    std::size_t freeSlots() const { return free_ids.size(); }
+    // все мертвые убираются: хвост отрезается, дыры в середине занимают нпс с конца,
+    // лишняя емкость возвращается. Переезды пишутся в moved, Uid не меняются.
+    // Вызывать, когда на мертвых никто не ссылается, а на слоты живых - только тот,
+    // кто поправит их по moved
+    void compact(std::vector<SlotMove>& moved);
+    // без списка переездов: на слоты никто не ссылается
+    void compact();
+
+    std::size_t size() const { return xs.size(); }
+    std::size_t aliveCount() const;
+
+    int getX(Id id) const { return xs[id]; }
+    int getY(Id id) const { return ys[id]; }
+    NpcType getType(Id id) const { return static_cast<NpcType>(types[id]); }
+    bool isAlive(Id id) const { return alive[id] != 0; }
+    Uid getUid(Id id) const { return uids[id]; }
+    int getMoveDist(Id id) const { return move_dists[id]; }
+    int getKillDist(Id id) const { return kill_dists[id]; }
+    // действительно до следующего add/spawn/append/compact
+    std::string_view getName(Id id) const { return names.get(name_ids[id]); }
+
+    void kill(Id id) { alive[id] = 0; }
+    // шаг зависит только от зерна запуска, тика и Uid
+    void moveRandom(Id id, std::uint32_t tick);
+    double distance(Id a, Id b) const;
+    int maxKillDist() const;
+
+    // снимок в виде обычного NPC (для визитора, наблюдателей и фабрики);
+    // память берется из пула мира, поэтому фасад не должен пережить мир
+    std::shared_ptr<NPC> npc(Id id) const;
+
+    // массивы целиком для линейных проходов
+    const std::vector<int>& getXs() const { return xs; }
+    const std::vector<int>& getYs() const { return ys; }
+    const std::vector<std::uint8_t>& getTypes() const { return types; }
+    const std::vector<std::uint8_t>& getAlive() const { return alive; }
+    const std::vector<int>& getKillDists() const { return kill_dists; }
+
+private:
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<std::uint8_t> types;
+    std::vector<std::uint8_t> alive;
+    std::vector<int> move_dists;
+    std::vector<int> kill_dists;
+    std::vector<NameTable::NameId> name_ids;  // холодные данные
+    std::vector<Uid> uids;
+    Uid next_uid = 0;
+    // имя переродившегося в слоте нпс дописывается в конец; старые имена копятся
+    // в stale_name_bytes, и когда их больше половины таблицы, она пересобирается
+    NameTable names;
+    std::size_t stale_name_bytes = 0;
+
+    std::vector<Id> free_ids;
+    std::vector<std::uint8_t> released;  // 1 - слот уже в free_ids; короче мира, если хвост не освобождали
+    // пул фасадов: частые npc(id) переиспользуют освобожденные блоки
+    std::unique_ptr<SlabResource> facade_pool;
+
+    void reclaimNames();
+};
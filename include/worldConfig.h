@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+// размеры карты и параметры партии; координаты нпс лежат в [0, width] x [0, height]
+struct WorldConfig {
+    static constexpr int MAX_SIDE = 1 << 30;  // разность координат влезает в int32, ее квадрат считается в int64
+
+    int width = 100;
+    int height = 100;
+    std::size_t npc_count = 50;
+    int duration = 30;  // секунд
+
+    bool contains(int x, int y) const { return x >= 0 && x <= width && y >= 0 && y <= height; }
+    // invalid_argument, если значения вне допустимых пределов
+    void validate() const;
+};
+
+// активная конфигурация, общая для всех потоков; задается до запуска потоков
+void setWorldConfig(const WorldConfig& config);
+const WorldConfig& worldConfig();
+
+// строки "ключ = значение" (width, height, npcs, duration), # - комментарий;
+// invalid_argument с номером строки при ошибке
+WorldConfig parseWorldConfig(std::istream& is, WorldConfig base = {});
+// изменяет одно поле по имени ключа, false для неизвестного ключа;
+// значение вне пределов validate - invalid_argument до записи в поле
+bool setConfigValue(WorldConfig& config, const std::string& key, const std::string& value);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "world.h"
+
+// копия горячих столбцов мира на конец тика; читается без блокировок
+struct WorldFrame {
+    std::uint32_t tick = 0;
+    std::size_t alive_count = 0;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<std::uint8_t> types;
+    std::vector<std::uint8_t> alive;
+
+    std::size_t size() const { return xs.size(); }
+};
+
+// публикация версий мира в духе RCU: писатель (поток тиков) копирует мир в свободный слот
+// и атомарно делает его текущим, читатели закрепляют текущий слот счетчиком.
+// Слотов фиксированное число, поэтому память ограничена; если все слоты, кроме текущего,
+// заняты читателями, версия пропускается - писатель никогда не ждет
+class WorldPublisher {
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        WorldFrame frame;
+        mutable std::atomic<std::uint32_t> readers{0};
+    };
+
+public:
+    // память версий не больше SLOTS копий горячих столбцов мира: граница держится
+    // только на этом числе, лишние версии пропускаются, а не копятся
+    static constexpr std::size_t SLOTS = 4;
+
+    // закрепленная версия; слот не перезаписывается, пока жив guard
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : slot(other.slot) { other.slot = nullptr; }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ~ReadGuard() {
+            if (slot) slot->readers.fetch_sub(1, std::memory_order_release);
+        }
+
+        const WorldFrame& operator*() const { return slot->frame; }
+        const WorldFrame* operator->() const { return &slot->frame; }
+
+    private:
+        friend class WorldPublisher;
+        explicit ReadGuard(const Slot* slot) : slot(slot) {}
+        const Slot* slot;
+    };
+
+    WorldPublisher() = default;
+    WorldPublisher(const WorldPublisher&) = delete;
+    WorldPublisher& operator=(const WorldPublisher&) = delete;
+
+    // последняя опубликованная версия (до первой публикации - пустой мир тика 0)
+    ReadGuard read() const;
+
+    // только из одного потока-писателя, пока мир не меняется;
+    // false - свободного слота нет, версия пропущена
+    bool publish(const World& world, std::uint32_t tick);
+
+    std::uint64_t published() const { return published_count.load(std::memory_order_relaxed); }
+    std::uint64_t skipped() const { return skipped_count.load(std::memory_order_relaxed); }
+
+private:
+    std::array<Slot, SLOTS> slots;
+    alignas(CACHE_LINE) std::atomic<std::uint32_t> current{0};
+    std::atomic<std::uint64_t> published_count{0};
+    std::atomic<std::uint64_t> skipped_count{0};
+};
@@ -0,0 +1,146 @@
+#include "asyncFileObserver.h"
+
+#include <charconv>
+
+#include "registry.h"
+#include "trace.h"
+
+namespace {
+
+void appendInt(std::string& batch, int value) {
+    char digits[16];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    batch.append(digits, res.ptr);
+}
+
+}
+
+AsyncFileObserver::AsyncFileObserver(const std::string& filename, AsyncLogConfig config)
+    : config(config), records(config.buffer_size) {
+    logfile.open(filename, std::ios::app);
+    writer = std::thread(&AsyncFileObserver::writerLoop, this);
+}
+
+AsyncFileObserver::~AsyncFileObserver() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+std::uint32_t AsyncFileObserver::storeName(std::string_view name, char (&out)[FightRecord::NAME_CAP]) {
+    if (name.size() < FightRecord::NAME_CAP) {
+        out[name.copy(out, name.size())] = '\0';
+        return FightRecord::NO_SPILL;
+    }
+    std::lock_guard<std::mutex> lock(spill_mutex);
+    std::uint32_t spill = next_spill++;
+    spilled_names.emplace(spill, name);
+    return spill;
+}
+
+void AsyncFileObserver::appendName(std::string& batch, const char* name, std::uint32_t spill) {
+    if (spill == FightRecord::NO_SPILL) {
+        batch += name;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(spill_mutex);
+    auto it = spilled_names.find(spill);
+    batch += it->second;
+    spilled_names.erase(it);
+}
+
+void AsyncFileObserver::releaseSpills(const FightRecord& record) {
+    if (record.attacker_spill == FightRecord::NO_SPILL && record.defender_spill == FightRecord::NO_SPILL) return;
+    std::lock_guard<std::mutex> lock(spill_mutex);
+    spilled_names.erase(record.attacker_spill);
+    spilled_names.erase(record.defender_spill);
+}
+
+// та же строка, что пишет FileObserver
+void AsyncFileObserver::format(const FightRecord& record, std::string& batch) {
+    batch += typeName(record.attacker_type);
+    batch += ' ';
+    appendName(batch, record.attacker_name, record.attacker_spill);
+    batch += " killed ";
+    batch += typeName(record.defender_type);
+    batch += ' ';
+    appendName(batch, record.defender_name, record.defender_spill);
+    batch += " at (";
+    appendInt(batch, record.x);
+    batch += ", ";
+    appendInt(batch, record.y);
+    batch += ")\n";
+}
+
+void AsyncFileObserver::onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) {
+    onFightEvent(makeEvent(*attacker, *defender, success));
+}
+
+void AsyncFileObserver::onFightEvent(const FightEvent& event) {
+    if (!event.killed) return;
+
+    FightRecord record;
+    record.attacker_type = event.attacker.type;
+    record.defender_type = event.defender.type;
+    record.x = event.defender.x;
+    record.y = event.defender.y;
+    record.attacker_spill = storeName(event.attacker.name, record.attacker_name);
+    record.defender_spill = storeName(event.defender.name, record.defender_name);
+
+    if (records.tryPush(record)) return;
+
+    // кольцо полно: будим писателя, не дожидаясь интервала
+    requestWake();
+    if (config.overflow == OverflowPolicy::Drop) {
+        releaseSpills(record);
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        records.push(record);
+    }
+}
+
+void AsyncFileObserver::requestWake() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_requested = true;
+    }
+    wake.notify_one();
+}
+
+std::size_t AsyncFileObserver::drainTo(std::string& batch) {
+    std::size_t count = 0;
+    FightRecord record;
+    while (records.tryPop(record)) {
+        format(record, batch);
+        ++count;
+    }
+    return count;
+}
+
+void AsyncFileObserver::writerLoop() {
+    traceThreadName("async log");
+    std::string batch;
+    bool done = false;
+    while (!done) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait_for(lock, config.flush_interval, [this] { return wake_requested || stopping; });
+            wake_requested = false;
+            done = stopping;
+        }
+
+        TRACE_SCOPE("async log batch", "observer");
+        batch.clear();
+        std::size_t count = drainTo(batch);
+        if (count == 0) continue;
+
+        if (logfile.is_open()) {
+            logfile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            logfile.flush();
+        }
+        written.fetch_add(count, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+#include "detect.h"
+#include "registry.h"
+#include "rng.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LAB7_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+static_assert(MAX_KIND_KILL_DIST <= MAX_KILL_DIST, "kill distance too large for the int32 kernel");
+
+namespace {
+
+constexpr int COORD_CLAMP = MAX_KILL_DIST + 1;
+
+inline int clampedDelta(int a, int b) {
+    return std::min(std::abs(a - b), COORD_CLAMP);
+}
+
+KillMasks scalarTail(int x, int y, int kill, const int* xs, const int* ys, const int* kills,
+                     std::size_t begin, std::size_t n, KillMasks masks) {
+    const int self_k2 = kill * kill;
+    for (std::size_t i = begin; i < n; ++i) {
+        int dx = clampedDelta(xs[i], x);
+        int dy = clampedDelta(ys[i], y);
+        int d2 = dx * dx + dy * dy;
+        if (d2 <= self_k2) masks.by_self |= 1u << i;
+        if (d2 <= kills[i] * kills[i]) masks.by_other |= 1u << i;
+    }
+    return masks;
+}
+
+#ifdef LAB7_X86_KERNELS
+
+__attribute__((target("avx2")))
+KillMasks killRangeMasksAvx2(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n) {
+    const __m256i vx = _mm256_set1_epi32(x);
+    const __m256i vy = _mm256_set1_epi32(y);
+    const __m256i limit = _mm256_set1_epi32(COORD_CLAMP);
+    const __m256i self_k2 = _mm256_set1_epi32(kill * kill);
+
+    KillMasks masks;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i));
+        __m256i py = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i));
+        __m256i pk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kills + i));
+
+        __m256i dx = _mm256_min_epi32(_mm256_abs_epi32(_mm256_sub_epi32(px, vx)), limit);
+        __m256i dy = _mm256_min_epi32(_mm256_abs_epi32(_mm256_sub_epi32(py, vy)), limit);
+        __m256i d2 = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+
+        // d2 <= k2 <=> !(d2 > k2)
+        __m256i out_self = _mm256_cmpgt_epi32(d2, self_k2);
+        __m256i out_other = _mm256_cmpgt_epi32(d2, _mm256_mullo_epi32(pk, pk));
+        std::uint32_t in_self = ~static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(out_self))) & 0xffu;
+        std::uint32_t in_other = ~static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(out_other))) & 0xffu;
+        masks.by_self |= in_self << i;
+        masks.by_other |= in_other << i;
+    }
+    // без vzeroupper вызов скалярного кода платит за переход AVX->SSE
+    _mm256_zeroupper();
+    return i == n ? masks : scalarTail(x, y, kill, xs, ys, kills, i, n, masks);
+}
+
+__attribute__((target("sse4.1")))
+KillMasks killRangeMasksSse41(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n) {
+    const __m128i vx = _mm_set1_epi32(x);
+    const __m128i vy = _mm_set1_epi32(y);
+    const __m128i limit = _mm_set1_epi32(COORD_CLAMP);
+    const __m128i self_k2 = _mm_set1_epi32(kill * kill);
+
+    KillMasks masks;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i));
+        __m128i py = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i));
+        __m128i pk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kills + i));
+
+        __m128i dx = _mm_min_epi32(_mm_abs_epi32(_mm_sub_epi32(px, vx)), limit);
+        __m128i dy = _mm_min_epi32(_mm_abs_epi32(_mm_sub_epi32(py, vy)), limit);
+        __m128i d2 = _mm_add_epi32(_mm_mullo_epi32(dx, dx), _mm_mullo_epi32(dy, dy));
+
+        __m128i out_self = _mm_cmpgt_epi32(d2, self_k2);
+        __m128i out_other = _mm_cmpgt_epi32(d2, _mm_mullo_epi32(pk, pk));
+        std::uint32_t in_self = ~static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(out_self))) & 0xfu;
+        std::uint32_t in_other = ~static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(out_other))) & 0xfu;
+        masks.by_self |= in_self << i;
+        masks.by_other |= in_other << i;
+    }
+    return i == n ? masks : scalarTail(x, y, kill, xs, ys, kills, i, n, masks);
+}
+
+#endif
+
+using Kernel = KillMasks (*)(int, int, int, const int*, const int*, const int*, std::size_t);
+
+struct KernelChoice {
+    Kernel fn;
+    const char* name;
+};
+
+KernelChoice selectKernel() {
+#ifdef LAB7_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {killRangeMasksAvx2, "avx2"};
+    if (__builtin_cpu_supports("sse4.1")) return {killRangeMasksSse41, "sse4.1"};
+#endif
+    return {killRangeMasksScalar, "scalar"};
+}
+
+const KernelChoice& kernel() {
+    static const KernelChoice choice = selectKernel();
+    return choice;
+}
+
+}
+
+KillMasks killRangeMasksScalar(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n) {
+    return scalarTail(x, y, kill, xs, ys, kills, 0, n, KillMasks{});
+}
+
+KillMasks killRangeMasks(int x, int y, int kill, const int* xs, const int* ys, const int* kills, std::size_t n) {
+    return kernel().fn(x, y, kill, xs, ys, kills, n);
+}
+
+const char* killRangeKernelName() {
+    return kernel().name;
+}
+
+void detectCell(const World& world, const std::vector<SpatialGrid::Id>& cell,
+                const std::vector<SpatialGrid::Id>* const* neighbors, std::size_t neighbor_count,
+                std::uint32_t tick, DetectScratch& scratch, std::vector<FightTask>& out) {
+    // ячейка и ее соседи копируются подряд, тогда кандидаты для i-го нпс ячейки -
+    // непрерывный диапазон [i + 1, total)
+    auto& [ids, xs, ys, kills] = scratch;
+    ids.clear();
+    xs.clear();
+    ys.clear();
+    kills.clear();
+
+    auto gather = [&](const std::vector<SpatialGrid::Id>& source) {
+        for (SpatialGrid::Id id : source) {
+            if (!world.isAlive(id)) continue;
+            ids.push_back(id);
+            xs.push_back(world.getX(id));
+            ys.push_back(world.getY(id));
+            kills.push_back(world.getKillDist(id));
+        }
+    };
+
+    gather(cell);
+    std::size_t own = ids.size();
+    for (std::size_t n = 0; n < neighbor_count; ++n) {
+        gather(*neighbors[n]);
+    }
+    std::size_t total = ids.size();
+
+    for (std::size_t i = 0; i < own; ++i) {
+        for (std::size_t begin = i + 1; begin < total; begin += KILL_BLOCK) {
+            std::size_t n = std::min(KILL_BLOCK, total - begin);
+            KillMasks masks = killRangeMasks(xs[i], ys[i], kills[i], &xs[begin], &ys[begin], &kills[begin], n);
+
+            std::uint32_t any = masks.by_self | masks.by_other;
+            while (any) {
+                int bit = std::countr_zero(any);
+                any &= any - 1;
+
+                World::Id a = ids[i];
+                World::Id b = ids[begin + bit];
+                bool a_reaches = masks.by_self & (1u << bit);
+                bool b_reaches = masks.by_other & (1u << bit);
+
+                if (a_reaches && b_reaches) {
+                    // жребий по паре Uid, а не по порядку в ячейках: после переездов
+                    // в compact порядок меняется, исход - нет
+                    World::Id lo = world.getUid(a) < world.getUid(b) ? a : b;
+                    World::Id hi = lo == a ? b : a;
+                    CounterRng rng(runSeed(), RngStream::TieBreak, tick, world.getUid(lo), world.getUid(hi));
+                    if (rng.below(2) == 0) {
+                        out.push_back({lo, hi, tick});
+                    } else {
+                        out.push_back({hi, lo, tick});
+                    }
+                } else if (a_reaches) {
+                    out.push_back({a, b, tick});
+                } else {
+                    out.push_back({b, a, tick});
+                }
+            }
+        }
+    }
+}
+
+void detectFights(const World& world, const SpatialGrid& grid, std::uint32_t tick, std::vector<FightTask>& out) {
+    std::vector<SpatialGrid::CellRef> cells;
+    grid.sortedCells(cells);
+
+    DetectScratch scratch;
+    for (const auto& cell : cells) {
+        const std::vector<SpatialGrid::Id>* neighbors[4];
+        std::size_t neighbor_count = grid.forwardNeighbors(cell.cx, cell.cy, neighbors);
+        detectCell(world, *cell.ids, neighbors, neighbor_count, tick, scratch, out);
+    }
+}
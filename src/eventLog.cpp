@@ -0,0 +1,310 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "eventLog.h"
+
+static_assert(std::endian::native == std::endian::little, "Event log format is little-endian");
+static_assert(sizeof(EventRecord) == 24, "Event record layout changed");
+static_assert(sizeof(EventLogHeader) == 32, "Event log header layout changed");
+static_assert(sizeof(EventBlockHeader) == 64, "Event block header layout changed");
+static_assert(NPC_KIND_COUNT <= EVENT_LOG_MAX_KINDS, "Block index has no room for all NPC kinds");
+
+namespace {
+
+EventLogHeader makeHeader() {
+    EventLogHeader header{};
+    std::memcpy(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC));
+    header.version = EVENT_LOG_VERSION;
+    header.record_size = sizeof(EventRecord);
+    header.block_header_size = sizeof(EventBlockHeader);
+    header.block_records = EVENT_BLOCK_RECORDS;
+    return header;
+}
+
+bool isSessionMark(const EventBlockHeader& header) {
+    return header.magic == EVENT_SESSION_MAGIC && header.count == 0;
+}
+
+bool isBlock(const EventBlockHeader& header) {
+    return header.magic == EVENT_BLOCK_MAGIC && header.count > 0 && header.count <= EVENT_BLOCK_RECORDS;
+}
+
+bool validHeader(const EventLogHeader& header) {
+    return std::memcmp(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC)) == 0 &&
+           header.version == EVENT_LOG_VERSION && header.record_size == sizeof(EventRecord) &&
+           header.block_header_size == sizeof(EventBlockHeader);
+}
+
+}
+
+EventLogWriter::EventLogWriter(const std::string& path, std::uint64_t seed) {
+    file = std::fopen(path.c_str(), "ab+");
+    if (!file) {
+        throw std::runtime_error("Cannot open event log: " + path);
+    }
+    block.reserve(EVENT_BLOCK_RECORDS);
+
+    // в режиме "a" запись всегда в конец, читать можно откуда угодно
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    if (size == 0) {
+        EventLogHeader header = makeHeader();
+        std::fwrite(&header, sizeof(header), 1, file);
+    } else {
+        EventLogHeader header{};
+        std::fseek(file, 0, SEEK_SET);
+        if (std::fread(&header, sizeof(header), 1, file) != 1 || !validHeader(header)) {
+            std::fclose(file);
+            file = nullptr;
+            throw std::runtime_error("Not an event log: " + path);
+        }
+
+        long end = completeEnd(size);
+        if (end < size) {
+            if (::ftruncate(::fileno(file), end) != 0) {
+                std::fclose(file);
+                file = nullptr;
+                throw std::runtime_error("Cannot cut torn tail of event log: " + path);
+            }
+            dropped_bytes = static_cast<std::uint64_t>(size - end);
+        }
+        // после чтения поток нельзя сразу писать: нужен fseek между ними
+        std::fseek(file, 0, SEEK_END);
+    }
+
+    EventBlockHeader mark{};
+    mark.magic = EVENT_SESSION_MAGIC;
+    mark.reserved[0] = seed;
+    mark.reserved[1] = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                      std::chrono::system_clock::now().time_since_epoch())
+                                                      .count());
+    std::fwrite(&mark, sizeof(mark), 1, file);
+    std::fflush(file);
+}
+
+long EventLogWriter::completeEnd(long file_size) {
+    long end = sizeof(EventLogHeader);
+    std::fseek(file, end, SEEK_SET);
+    EventBlockHeader header;
+    // те же проверки, что у читателя: блок целый, если цел заголовок и хватает байт на записи
+    while (std::fread(&header, sizeof(header), 1, file) == 1 && (isBlock(header) || isSessionMark(header))) {
+        long next = end + static_cast<long>(sizeof(header) + header.count * sizeof(EventRecord));
+        if (next > file_size) break;
+        end = next;
+        std::fseek(file, end, SEEK_SET);
+    }
+    return end;
+}
+
+EventLogWriter::~EventLogWriter() {
+    if (file) {
+        flush();
+        std::fclose(file);
+    }
+}
+
+void EventLogWriter::append(const EventRecord& record) {
+    block.push_back(record);
+    if (block.size() == EVENT_BLOCK_RECORDS) flush();
+}
+
+void EventLogWriter::flush() {
+    if (block.empty()) return;
+
+    EventBlockHeader header{};
+    header.magic = EVENT_BLOCK_MAGIC;
+    header.count = static_cast<std::uint32_t>(block.size());
+    header.min_tick = UINT32_MAX;
+    for (const EventRecord& record : block) {
+        header.min_tick = std::min(header.min_tick, record.tick);
+        header.max_tick = std::max(header.max_tick, record.tick);
+        if (record.killed && record.attacker_type < EVENT_LOG_MAX_KINDS) ++header.kills[record.attacker_type];
+    }
+
+    // заголовок и записи одним fwrite-блоком: блок в файле либо целый, либо обрезан в хвосте
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(block.data(), sizeof(EventRecord), block.size(), file);
+    std::fflush(file);
+    written += block.size();
+    block.clear();
+}
+
+void BinaryLogObserver::onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender,
+                                bool success) {
+    onFightEvent(makeEvent(*attacker, *defender, success));
+}
+
+void BinaryLogObserver::onFightEvent(const FightEvent& event) {
+    writer.append({event.tick, event.attacker.id, event.defender.id, event.defender.x, event.defender.y,
+                   static_cast<std::uint8_t>(event.attacker.type), static_cast<std::uint8_t>(event.defender.type),
+                   static_cast<std::uint8_t>(event.success ? 1 : 0), static_cast<std::uint8_t>(event.killed ? 1 : 0)});
+}
+
+EventLogReader::EventLogReader(const std::string& path) {
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("Cannot open event log: " + path);
+    }
+    EventLogHeader header{};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || !validHeader(header)) {
+        std::fclose(file);
+        file = nullptr;
+        throw std::runtime_error("Not an event log: " + path);
+    }
+    buffer.resize(EVENT_BLOCK_RECORDS);
+
+    // список сессий - только по заголовкам блоков
+    scanAll(
+        [&](std::size_t index, const EventBlockHeader& header) {
+            if (index >= session_list.size()) session_list.resize(index + 1);
+            EventSession& s = session_list[index];
+            if (isSessionMark(header)) {
+                s.seed = header.reserved[0];
+                s.start_ms = header.reserved[1];
+                return false;
+            }
+            ++s.blocks;
+            s.records += header.count;
+            s.first_tick = std::min(s.first_tick, header.min_tick);
+            s.last_tick = std::max(s.last_tick, header.max_tick);
+            return false;
+        },
+        [](const EventBlockHeader&, const EventRecord*, std::size_t) {});
+    if (!session_list.empty()) session = session_list.size() - 1;
+}
+
+EventLogReader::~EventLogReader() {
+    if (file) std::fclose(file);
+}
+
+void EventLogReader::selectSession(std::size_t index) {
+    if (index >= session_list.size()) {
+        throw std::out_of_range("No event log session " + std::to_string(index));
+    }
+    session = index;
+}
+
+void EventLogReader::scan(const std::function<bool(const EventBlockHeader&)>& want,
+                          const std::function<void(const EventBlockHeader&, const EventRecord*, std::size_t)>& fn) {
+    scanAll(
+        [&](std::size_t index, const EventBlockHeader& header) {
+            return index == session && !isSessionMark(header) && want(header);
+        },
+        fn);
+}
+
+void EventLogReader::scanAll(const std::function<bool(std::size_t, const EventBlockHeader&)>& want,
+                             const std::function<void(const EventBlockHeader&, const EventRecord*, std::size_t)>& fn) {
+    std::fseek(file, 0, SEEK_END);
+    long end = std::ftell(file);
+    std::fseek(file, sizeof(EventLogHeader), SEEK_SET);
+    bytes_read = sizeof(EventLogHeader);
+    truncated_tail = false;
+
+    // метка открывает сессию; блоки до первой метки, если они есть, - сессия 0
+    std::size_t index = 0;
+    bool seen = false;
+    EventBlockHeader header;
+    for (;;) {
+        std::size_t got = std::fread(&header, 1, sizeof(header), file);
+        if (got == 0) return;
+        if (got != sizeof(header) || !(isBlock(header) || isSessionMark(header))) {
+            truncated_tail = true;
+            return;
+        }
+        bytes_read += sizeof(header);
+        if (isSessionMark(header) && seen) ++index;
+        seen = true;
+
+        if (!want(index, header)) {
+            long skip = static_cast<long>(header.count * sizeof(EventRecord));
+            long here = std::ftell(file);
+            if (end - here < skip) {
+                truncated_tail = true;
+                return;
+            }
+            std::fseek(file, here + skip, SEEK_SET);
+            continue;
+        }
+        if (std::fread(buffer.data(), sizeof(EventRecord), header.count, file) != header.count) {
+            truncated_tail = true;
+            return;
+        }
+        bytes_read += header.count * sizeof(EventRecord);
+        fn(header, buffer.data(), header.count);
+    }
+}
+
+std::vector<KillWindow> killsPerSpecies(EventLogReader& reader, std::uint32_t from, std::uint32_t to,
+                                        std::uint32_t window) {
+    // диапазон по умолчанию может быть огромным: сужаем до тиков журнала по заголовкам
+    std::uint32_t first_tick = UINT32_MAX;
+    std::uint32_t last_tick = 0;
+    reader.scan(
+        [&](const EventBlockHeader& header) {
+            first_tick = std::min(first_tick, header.min_tick);
+            last_tick = std::max(last_tick, header.max_tick);
+            return false;
+        },
+        [](const EventBlockHeader&, const EventRecord*, std::size_t) {});
+    if (window == 0) {
+        from = std::max(from, first_tick);
+    } else if (first_tick > from) {
+        from += (first_tick - from) / window * window;  // окна по-прежнему отсчитываются от исходного from
+    }
+    to = std::min(to, last_tick);
+    if (to < from) return {};
+    std::uint64_t span = static_cast<std::uint64_t>(to) - from + 1;
+    std::uint64_t width = window == 0 ? span : window;
+    std::vector<KillWindow> windows((span + width - 1) / width);
+    for (std::size_t w = 0; w < windows.size(); ++w) {
+        windows[w].from_tick = static_cast<std::uint32_t>(from + w * width);
+    }
+    auto windowOf = [&](std::uint32_t tick) { return static_cast<std::size_t>((tick - from) / width); };
+
+    reader.scan(
+        [&](const EventBlockHeader& header) {
+            if (header.max_tick < from || header.min_tick > to) return false;
+            // блок целиком в одном окне - хватает индекса из заголовка
+            if (header.min_tick >= from && header.max_tick <= to && windowOf(header.min_tick) == windowOf(header.max_tick)) {
+                auto& kills = windows[windowOf(header.min_tick)].kills;
+                for (std::size_t kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+                    kills[kind] += header.kills[kind];
+                }
+                return false;
+            }
+            return true;
+        },
+        [&](const EventBlockHeader&, const EventRecord* records, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const EventRecord& record = records[i];
+                if (!record.killed || record.tick < from || record.tick > to ||
+                    record.attacker_type >= NPC_KIND_COUNT) {
+                    continue;
+                }
+                ++windows[windowOf(record.tick)].kills[record.attacker_type];
+            }
+        });
+
+    windows.erase(std::remove_if(windows.begin(), windows.end(), [](const KillWindow& w) {
+                      return std::all_of(w.kills.begin(), w.kills.end(), [](std::uint64_t k) { return k == 0; });
+                  }),
+                  windows.end());
+    return windows;
+}
+
+std::vector<EventRecord> npcHistory(EventLogReader& reader, std::uint32_t id) {
+    std::vector<EventRecord> history;
+    reader.scan([](const EventBlockHeader&) { return true; },
+                [&](const EventBlockHeader&, const EventRecord* records, std::size_t count) {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (records[i].attacker == id || records[i].defender == id) history.push_back(records[i]);
+                    }
+                });
+    return history;
+}
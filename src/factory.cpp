@@ -1,19 +1,113 @@
+#include <charconv>
+#include <iterator>
+
 #include "factory.h"
-#include "toad.h"     
-#include "dragon.h"
-#include "knight.h"
+#include "registry.h"
+#include "threadPool.h"
+#include "worldConfig.h"
+
+namespace {
+
+// столбцы одного куска текста, как их ждет World::append
+struct ParsedChunk {
+    std::vector<std::uint8_t> types;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::int32_t> xs;
+    std::vector<std::int32_t> ys;
+    std::string names;
+    std::vector<std::uint32_t> name_offsets{0};
+    std::vector<ImportError> errors;  // номера строк внутри куска
+    std::size_t lines = 0;
+};
+
+const std::size_t CHUNK_BYTES = 1 << 20;
+const std::size_t SAVE_BUFFER = 1 << 20;
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+std::string_view nextToken(std::string_view& line) {
+    std::size_t begin = 0;
+    while (begin < line.size() && isSpace(line[begin])) ++begin;
+    std::size_t end = begin;
+    while (end < line.size() && !isSpace(line[end])) ++end;
+    std::string_view token = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+    return token;
+}
+
+bool parseCoord(std::string_view token, int& out) {
+    auto res = std::from_chars(token.data(), token.data() + token.size(), out);
+    return res.ec == std::errc() && res.ptr == token.data() + token.size();
+}
+
+// nullptr - строка разобрана (или пуста), иначе текст ошибки
+const char* parseLine(std::string_view line, ParsedChunk& chunk) {
+    std::string_view type_token = nextToken(line);
+    if (type_token.empty()) return nullptr;
+
+    auto type = parseType(type_token);
+    if (!type) return "unknown NPC type";
+
+    std::string_view name = nextToken(line);
+    std::string_view x_token = nextToken(line);
+    std::string_view y_token = nextToken(line);
+    if (y_token.empty()) return "expected: type name x y";
+    if (!nextToken(line).empty()) return "unexpected trailing data";
+
+    int x, y;
+    if (!parseCoord(x_token, x) || !parseCoord(y_token, y)) return "coordinates must be integers";
+    if (!worldConfig().contains(x, y)) return "NPC coordinates must be inside the map";
+
+    chunk.types.push_back(static_cast<std::uint8_t>(*type));
+    chunk.alive.push_back(1);
+    chunk.xs.push_back(x);
+    chunk.ys.push_back(y);
+    chunk.names += name;
+    chunk.name_offsets.push_back(static_cast<std::uint32_t>(chunk.names.size()));
+    return nullptr;
+}
+
+void parseChunk(std::string_view text, ParsedChunk& chunk) {
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        ++chunk.lines;
+        if (const char* error = parseLine(line, chunk)) {
+            chunk.errors.push_back({chunk.lines, error});
+        }
+        if (end == std::string_view::npos) break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+// куски примерно по CHUNK_BYTES, граница всегда после '\n'
+std::vector<std::string_view> splitChunks(std::string_view text) {
+    std::vector<std::string_view> chunks;
+    while (!text.empty()) {
+        std::size_t end = text.size();
+        if (end > CHUNK_BYTES) {
+            std::size_t nl = text.find('\n', CHUNK_BYTES);
+            end = nl == std::string_view::npos ? text.size() : nl + 1;
+        }
+        chunks.push_back(text.substr(0, end));
+        text.remove_prefix(end);
+    }
+    return chunks;
+}
+
+void appendInt(std::string& buffer, int value) {
+    char digits[16];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, res.ptr);
+}
+
+}
 
 std::shared_ptr<NPC> NPCFactory::create(NpcType type, const std::string& name, int x, int y) {
-    switch (type) {
-        case NpcType::Toad:    
-            return std::make_shared<Toad>(name, x, y);
-        case NpcType::Dragon:
-            return std::make_shared<Dragon>(name, x, y);
-        case NpcType::Knight:
-            return std::make_shared<Knight>(name, x, y);
-        default:
-            return nullptr;
+    if (!isValidType(type)) {
+        return nullptr;
     }
+    return makeNpc(type, name, x, y);
 }
 
 std::shared_ptr<NPC> NPCFactory::create(std::istream& is) {
@@ -21,12 +115,8 @@ std::shared_ptr<NPC> NPCFactory::create(std::istream& is) {
     int x, y;
     
     if (is >> type >> name >> x >> y) {
-        if (type == "Toad") { 
-            return std::make_shared<Toad>(name, x, y);
-        } else if (type == "Dragon") {
-            return std::make_shared<Dragon>(name, x, y);
-        } else if (type == "Knight") {
-            return std::make_shared<Knight>(name, x, y);
+        if (auto parsed = parseType(type)) {
+            return makeNpc(*parsed, name, x, y);
         }
     }
     return nullptr;
@@ -34,6 +124,72 @@ std::shared_ptr<NPC> NPCFactory::create(std::istream& is) {
 
 void NPCFactory::save(const std::shared_ptr<NPC>& npc, std::ostream& os) {
     if (npc) {
-        os << npc->getType() << " " << npc->getName() << " " << npc->getX() << " " << npc->getY() << "\n";
+        // " x y\n": int занимает не больше 11 символов
+        char coords[32];
+        char* end = coords;
+        *end++ = ' ';
+        end = std::to_chars(end, coords + 12, npc->getX()).ptr;
+        *end++ = ' ';
+        end = std::to_chars(end, coords + 24, npc->getY()).ptr;
+        *end++ = '\n';
+        os << npc->getType() << ' ' << npc->getName();
+        os.write(coords, end - coords);
+    }
+}
+
+ImportResult NPCFactory::load(std::string_view text, World& world, ThreadPool* pool) {
+    std::vector<std::string_view> pieces = splitChunks(text);
+    std::vector<ParsedChunk> chunks(pieces.size());
+
+    auto parse = [&](std::size_t i) { parseChunk(pieces[i], chunks[i]); };
+    if (pool && pieces.size() > 1) {
+        pool->parallelFor(pieces.size(), parse);
+    } else {
+        for (std::size_t i = 0; i < pieces.size(); ++i) parse(i);
     }
-}
\ No newline at end of file
+
+    // склейка по порядку кусков: номера строк сквозные, порядок id как в тексте
+    ImportResult result;
+    std::size_t total = 0;
+    for (const auto& chunk : chunks) total += chunk.types.size();
+    world.reserve(world.size() + total);
+
+    std::size_t first_line = 0;
+    for (const auto& chunk : chunks) {
+        std::size_t n = chunk.types.size();
+        world.append(n, chunk.types.data(), chunk.alive.data(), chunk.xs.data(), chunk.ys.data(),
+                     chunk.names.data(), chunk.name_offsets.data());
+        result.loaded += n;
+        for (const auto& error : chunk.errors) {
+            result.errors.push_back({first_line + error.line, error.message});
+        }
+        first_line += chunk.lines;
+    }
+    return result;
+}
+
+ImportResult NPCFactory::load(std::istream& is, World& world, ThreadPool* pool) {
+    std::string text(std::istreambuf_iterator<char>(is), {});
+    return load(text, world, pool);
+}
+
+void NPCFactory::save(const World& world, std::ostream& os) {
+    std::string buffer;
+    buffer.reserve(SAVE_BUFFER + 256);
+    for (World::Id id = 0; id < world.size(); ++id) {
+        if (!world.isAlive(id)) continue;
+        buffer += typeName(world.getType(id));
+        buffer += ' ';
+        buffer += world.getName(id);
+        buffer += ' ';
+        appendInt(buffer, world.getX(id));
+        buffer += ' ';
+        appendInt(buffer, world.getY(id));
+        buffer += '\n';
+        if (buffer.size() >= SAVE_BUFFER) {
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
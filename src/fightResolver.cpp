@@ -0,0 +1,95 @@
+#include <algorithm>
+
+#include "fightResolver.h"
+#include "fightVisitor.h"
+#include "simulation.h"
+#include "trace.h"
+
+void FightResolver::split(const std::vector<FightTask>& tasks, std::size_t world_size) {
+    if (last_batch.size() < world_size) last_batch.resize(world_size, 0);
+    batch_of.resize(tasks.size());
+
+    std::uint32_t batches = 0;
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const FightTask& task = tasks[i];
+        std::uint32_t batch = std::max(last_batch[task.attacker], last_batch[task.defender]) + 1;
+        batch_of[i] = batch;
+        last_batch[task.attacker] = batch;
+        last_batch[task.defender] = batch;
+        batches = std::max(batches, batch);
+    }
+    // сброс только тронутых, чтобы не чистить массив размером с мир
+    for (const FightTask& task : tasks) {
+        last_batch[task.attacker] = 0;
+        last_batch[task.defender] = 0;
+    }
+
+    // устойчивая сортировка подсчетом: внутри пачки задачи в исходном порядке
+    batch_starts.assign(batches + 2, 0);
+    for (std::uint32_t batch : batch_of) {
+        ++batch_starts[batch + 1];
+    }
+    for (std::size_t b = 1; b < batch_starts.size(); ++b) {
+        batch_starts[b] += batch_starts[b - 1];
+    }
+    order.resize(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        order[batch_starts[batch_of[i]]++] = static_cast<std::uint32_t>(i);
+    }
+    // после раскладки batch_starts[b] - конец пачки b, то есть начало b + 1
+    batch_starts.pop_back();
+}
+
+void FightResolver::resolveRange(World& world, const std::vector<FightTask>& tasks, std::size_t begin,
+                                 std::size_t end) {
+    for (std::size_t k = begin; k < end; ++k) {
+        std::uint32_t i = order[k];
+        const FightTask& task = tasks[i];
+        if (!world.isAlive(task.attacker) || !world.isAlive(task.defender)) {
+            outcomes[i] = Skipped;
+        } else {
+            outcomes[i] = resolveFight(world, task, nullptr) ? Killed : Fought;
+        }
+    }
+}
+
+std::size_t FightResolver::resolve(World& world, const std::vector<FightTask>& tasks,
+                                   const std::shared_ptr<IFFightObserver>& observer) {
+    if (pool.size() == 1) {
+        batch_starts.clear();
+        return resolveFights(world, tasks, observer);
+    }
+
+    {
+        TRACE_SCOPE("split batches", "fight");
+        split(tasks, world.size());
+    }
+    outcomes.resize(tasks.size());
+
+    for (std::size_t b = 1; b < batch_starts.size(); ++b) {
+        std::size_t begin = batch_starts[b - 1];
+        std::size_t end = batch_starts[b];
+        std::size_t n = end - begin;
+        if (n < MIN_PARALLEL_BATCH || pool.size() == 1) {
+            resolveRange(world, tasks, begin, end);
+            continue;
+        }
+        // нпс пачки не пересекаются: потоки пишут разные байты alive
+        TRACE_SCOPE("parallel batch", "fight");
+        pool.parallelFor((n + CHUNK - 1) / CHUNK, [&](std::size_t chunk) {
+            std::size_t from = begin + chunk * CHUNK;
+            resolveRange(world, tasks, from, std::min(end, from + CHUNK));
+        });
+    }
+
+    TRACE_SCOPE("replay events", "fight");
+    std::size_t kills = 0;
+    WorldFightVisitor visitor(world, observer.get());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        if (outcomes[i] == Skipped) continue;
+        // имена, типы и координаты в фазе боев не меняются, событие то же, что при последовательном разборе
+        if (observer) visitor.visit(tasks[i].attacker, tasks[i].defender, tasks[i].tick, outcomes[i] == Killed);
+        if (outcomes[i] == Killed) ++kills;
+    }
+    return kills;
+}
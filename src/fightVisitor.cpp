@@ -1,32 +1,25 @@
 #include "fightVisitor.h"
 #include "observer.h"
-#include "toad.h"    
-#include "dragon.h"
-#include "knight.h"
+#include "registry.h"
 
 FightVisitor::FightVisitor(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<IFFightObserver>& observer)
     : attacker(attacker), observer(observer) {}
 
-bool FightVisitor::visit(const std::shared_ptr<Toad>& defender) {   
-    bool success = attacker->fight(defender);
+bool FightVisitor::visit(const std::shared_ptr<NPC>& defender) {
+    bool success = canKill(attacker->getTypeTag(), defender->getTypeTag());
     if (observer) { // наблюдатель передается в визитор
         observer->onFight(attacker, defender, success);
     }
     return success;
 }
 
-bool FightVisitor::visit(const std::shared_ptr<Dragon>& defender) {
-    bool success = attacker->fight(defender);
-    if (observer) {
-        observer->onFight(attacker, defender, success);
-    }
-    return success;
-}
 
-bool FightVisitor::visit(const std::shared_ptr<Knight>& defender) {
-    bool success = attacker->fight(defender);
+bool WorldFightVisitor::visit(World::Id attacker, World::Id defender, std::uint32_t tick, bool killed) const {
+    bool success = canKill(world.getType(attacker), world.getType(defender));
     if (observer) {
-        observer->onFight(attacker, defender, success);
+        observer->onFightEvent({{world.getType(attacker), world.getName(attacker), world.getX(attacker), world.getY(attacker), world.getUid(attacker)},
+                                {world.getType(defender), world.getName(defender), world.getX(defender), world.getY(defender), world.getUid(defender)},
+                                success, tick, killed});
     }
     return success;
-}
\ No newline at end of file
+}
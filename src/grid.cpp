@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "grid.h"
+
+SpatialGrid::SpatialGrid(int cell_size) : cell_size(cell_size) {
+    if (cell_size <= 0) {
+        throw std::invalid_argument("Grid cell size must be positive");
+    }
+}
+
+int SpatialGrid::cellCoord(int v) const {
+    // деление с округлением вниз, чтобы отрицательные координаты не слипались с нулевой ячейкой
+    int q = v / cell_size;
+    return (v % cell_size < 0) ? q - 1 : q;
+}
+
+SpatialGrid::Key SpatialGrid::makeKey(int cx, int cy) {
+    return (static_cast<Key>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+}
+
+std::size_t SpatialGrid::home(Key key) const {
+    // фибоначчиево хеширование: соседние ячейки расходятся по таблице
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & table_mask;
+}
+
+std::uint32_t SpatialGrid::findSlot(Key key) const {
+    if (table_slots.empty()) return NO_SLOT;
+    for (std::size_t i = home(key);; i = (i + 1) & table_mask) {
+        if (table_slots[i] == NO_SLOT) return NO_SLOT;
+        if (table_keys[i] == key) return table_slots[i];
+    }
+}
+
+void SpatialGrid::growTable() {
+    std::size_t capacity = table_slots.empty() ? 64 : table_slots.size() * 2;
+    table_keys.assign(capacity, 0);
+    table_slots.assign(capacity, NO_SLOT);
+    table_mask = capacity - 1;
+
+    for (std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+        if (slots[slot].ids.empty()) continue;
+        Key key = makeKey(slots[slot].cx, slots[slot].cy);
+        std::size_t i = home(key);
+        while (table_slots[i] != NO_SLOT) i = (i + 1) & table_mask;
+        table_keys[i] = key;
+        table_slots[i] = slot;
+    }
+}
+
+std::uint32_t SpatialGrid::findOrAddSlot(int cx, int cy) {
+    Key key = makeKey(cx, cy);
+    if (std::uint32_t slot = findSlot(key); slot != NO_SLOT) return slot;
+
+    // заполненность таблицы не выше 1/2
+    if ((live_cells + 1) * 2 > table_slots.size()) growTable();
+
+    std::uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot].cx = cx;
+        slots[slot].cy = cy;
+    } else {
+        slot = static_cast<std::uint32_t>(slots.size());
+        slots.push_back({cx, cy, {}});
+    }
+
+    std::size_t i = home(key);
+    while (table_slots[i] != NO_SLOT) i = (i + 1) & table_mask;
+    table_keys[i] = key;
+    table_slots[i] = slot;
+    ++live_cells;
+    return slot;
+}
+
+void SpatialGrid::eraseKey(Key key) {
+    std::size_t i = home(key);
+    while (table_keys[i] != key || table_slots[i] == NO_SLOT) i = (i + 1) & table_mask;
+
+    // удаление со сдвигом назад: цепочки пробирования остаются без дыр
+    for (std::size_t j = (i + 1) & table_mask; table_slots[j] != NO_SLOT; j = (j + 1) & table_mask) {
+        std::size_t h = home(table_keys[j]);
+        bool movable = (i <= j) ? (h <= i || h > j) : (h <= i && h > j);
+        if (movable) {
+            table_keys[i] = table_keys[j];
+            table_slots[i] = table_slots[j];
+            i = j;
+        }
+    }
+    table_slots[i] = NO_SLOT;
+    --live_cells;
+}
+
+void SpatialGrid::insert(Id id, int x, int y) {
+    slots[findOrAddSlot(cellCoord(x), cellCoord(y))].ids.push_back(id);
+    ++count;
+}
+
+void SpatialGrid::remove(Id id, int x, int y) {
+    Key key = makeKey(cellCoord(x), cellCoord(y));
+    std::uint32_t slot = findSlot(key);
+    if (slot == NO_SLOT) return;
+
+    auto& ids = slots[slot].ids;
+    auto pos = std::find(ids.begin(), ids.end(), id);
+    if (pos == ids.end()) return;
+
+    *pos = ids.back();
+    ids.pop_back();
+    --count;
+    if (ids.empty()) {
+        eraseKey(key);
+        free_slots.push_back(slot);
+    }
+}
+
+void SpatialGrid::move(Id id, int old_x, int old_y, int new_x, int new_y) {
+    if (cellCoord(old_x) == cellCoord(new_x) && cellCoord(old_y) == cellCoord(new_y)) {
+        return;
+    }
+    remove(id, old_x, old_y);
+    insert(id, new_x, new_y);
+}
+
+void SpatialGrid::rename(Id from, Id to, int x, int y) {
+    std::uint32_t slot = findSlot(makeKey(cellCoord(x), cellCoord(y)));
+    if (slot == NO_SLOT) return;
+    auto& ids = slots[slot].ids;
+    auto pos = std::find(ids.begin(), ids.end(), from);
+    if (pos != ids.end()) *pos = to;
+}
+
+void SpatialGrid::sortedCells(std::vector<CellRef>& out) const {
+    out.clear();
+    out.reserve(live_cells);
+    for (const auto& cell : slots) {
+        if (!cell.ids.empty()) out.push_back({cell.cx, cell.cy, &cell.ids});
+    }
+    std::sort(out.begin(), out.end(), [](const CellRef& a, const CellRef& b) {
+        return a.cx != b.cx ? a.cx < b.cx : a.cy < b.cy;
+    });
+}
+
+std::size_t SpatialGrid::forwardNeighbors(int cx, int cy, const std::vector<Id>* (&out)[4]) const {
+    // половина соседей, чтобы каждая пара ячеек просматривалась один раз
+    static constexpr int offsets[4][2] = {{1, -1}, {1, 0}, {1, 1}, {0, 1}};
+
+    std::size_t count = 0;
+    for (const auto& off : offsets) {
+        std::uint32_t slot = findSlot(makeKey(cx + off[0], cy + off[1]));
+        if (slot != NO_SLOT) {
+            out[count++] = &slots[slot].ids;
+        }
+    }
+    return count;
+}
+
+void SpatialGrid::clear() {
+    slots.clear();
+    free_slots.clear();
+    table_keys.clear();
+    table_slots.clear();
+    table_mask = 0;
+    live_cells = 0;
+    count = 0;
+}
@@ -1,43 +1,91 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
-#include <set>
-#include <random>
 #include <string>
 #include <sstream>
 #include <thread>
 #include <atomic>
 #include <chrono>
 #include <mutex>
-#include <shared_mutex>
 #include <vector>
-#include <cstdlib>
+#include <cstdint>
 #include <ctime>
+#include <algorithm>
+#include <functional>
+#include <array>
+#include <charconv>
+#include <climits>
+#include <string_view>
+#include <iomanip>
 
 #include "npc.h"
 #include "factory.h"
 #include "observer.h"
-#include "fightVisitor.h"
+#include "detect.h"
+#include "world.h"
+#include "registry.h"
+#include "rng.h"
+#include "boundedQueue.h"
+#include "simulation.h"
+#include "threadPool.h"
+#include "scheduler.h"
+#include "worldConfig.h"
+#include "renderer.h"
+#include "worldPublisher.h"
+#include "fightResolver.h"
+#include "metrics.h"
+#include "trace.h"
+#include "eventLog.h"
 
-using set_t = std::set<std::shared_ptr<NPC>>;
+// окно отрисовки в символах; большая карта ужимается в него
+const int VIEW_WIDTH = 80;
+const int VIEW_HEIGHT = 30;
 
-const int MAP_WIDTH = 100;        
-const int MAP_HEIGHT = 100;       
-const int GAME_DURATION = 30;     
-const int INITIAL_NPC_COUNT = 50; 
+// мир меняет только поток тиков (и поток боев, пока поток тиков ждет его), поэтому
+// без мьютекса: остальные читают опубликованные версии или ждут join
+World game_world;
 
-std::shared_mutex game_world_mutex; 
-set_t game_world;                 
+// версия мира на конец тика для отрисовки; читается без блокировок
+WorldPublisher world_frames;
 
 std::atomic<bool> game_running{true}; 
 std::mutex cout_mutex;              // для защиты вывода
 
-// для хран задач
-std::vector<std::pair<std::shared_ptr<NPC>, std::shared_ptr<NPC>>> fight_tasks;
-std::mutex tasks_mutex;            
+const std::size_t FIGHT_QUEUE_CAPACITY = 1 << 16;
 
-std::string generateName(const std::string& type, int n) {
-    return type + "_" + std::to_string(n);
+// для хран задач; задача с END_OF_TICK вместо участников закрывает тик.
+// Кольцо - только передача между потоками: detect собирает бои тика до первого push,
+// поток боев копит тик целиком. Шаг в ногу не дает парам копиться между тиками,
+// а MAX_FIGHTS_PER_TICK - внутри тика: тик целиком с END_OF_TICK влезает в кольцо
+const World::Id END_OF_TICK = UINT32_MAX;
+const std::size_t MAX_FIGHTS_PER_TICK = FIGHT_QUEUE_CAPACITY - 1;
+BoundedQueue<FightTask> fight_tasks(FIGHT_QUEUE_CAPACITY);
+
+// последний тик, чьи бои разобраны; тик ждет его, чтобы запуск с --seed
+// не зависел от того, как планировщик чередует потоки
+std::atomic<std::uint32_t> resolved_tick{0};
+std::atomic<std::uint64_t> kill_count{0};
+
+const std::chrono::milliseconds TICK_STEP{100};
+
+Gauge& queue_depth = metrics().gauge("npc_fight_queue_depth", "Fight tasks waiting in the queue");
+
+// "Type_n" в буфер вызывающего, без временных строк
+std::string_view generateName(std::string_view type, std::size_t n, std::array<char, 64>& buffer) {
+    char* end = std::copy(type.begin(), type.end(), buffer.data());
+    *end++ = '_';
+    end = std::to_chars(end, buffer.data() + buffer.size(), n).ptr;
+    return {buffer.data(), static_cast<std::size_t>(end - buffer.data())};
+}
+
+// значение флага - целое без знака целиком и не больше max, иначе invalid_argument
+unsigned long long parseUnsigned(const std::string& flag, const std::string& value, unsigned long long max) {
+    unsigned long long result = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (value.empty() || error != std::errc() || end != value.data() + value.size() || result > max) {
+        throw std::invalid_argument("Bad value for " + flag + ": " + value);
+    }
+    return result;
 }
 
 void safePrint(const std::string& mess) {
@@ -45,226 +93,342 @@ void safePrint(const std::string& mess) {
     std::cout << mess << std::endl;
 }
 
-void movementThread() {
-    while (game_running) {
-        std::vector<std::shared_ptr<NPC>> alive_npcs;
-        
-        {
-            std::shared_lock<std::shared_mutex> lock(game_world_mutex);
-            for (const auto& npc : game_world) {
-                if (npc->isAlive()) {
-                    alive_npcs.push_back(npc);
-                }
-            }
-        }
-    
-        for (auto& npc : alive_npcs) {
-            npc->moveRandom(); 
-        }
-        
-        std::vector<std::pair<std::shared_ptr<NPC>, std::shared_ptr<NPC>>> new_fights;
-        
-        for (size_t i = 0; i < alive_npcs.size(); ++i) {
-            if (!alive_npcs[i]->isAlive()) continue;
-            
-            for (size_t j = i + 1; j < alive_npcs.size(); ++j) {
-                if (!alive_npcs[j]->isAlive()) continue;
-                
-                double distance = alive_npcs[i]->distance(alive_npcs[j]);
-                int kill_distance_i = alive_npcs[i]->getKillDist();
-                int kill_distance_j = alive_npcs[j]->getKillDist();
-                
-                if (distance <= kill_distance_i || distance <= kill_distance_j) {
-                    if (distance <= kill_distance_i && distance <= kill_distance_j) {
-                        if (std::rand() % 2 == 0) {
-                            new_fights.push_back({alive_npcs[i], alive_npcs[j]});
-                        } else {
-                            new_fights.push_back({alive_npcs[j], alive_npcs[i]});
-                        }
-                    } else if (distance <= kill_distance_i) {
-                        new_fights.push_back({alive_npcs[i], alive_npcs[j]});
-                    } else {
-                        new_fights.push_back({alive_npcs[j], alive_npcs[i]});
-                    }
-                }
-            }
+// легенда карты из реестра видов: T=Toad(1/10) ...
+std::string kindLegend() {
+    std::string legend;
+    for (const auto& info : KIND_INFO) {
+        if (!legend.empty()) legend += ' ';
+        legend += std::string(1, info.symbol) + "=" + std::string(info.name) + "(" +
+                  std::to_string(info.move_dist) + "/" + std::to_string(info.kill_dist) + ")";
+    }
+    return legend;
+}
+
+// тики с фиксированным шагом; фаза боев отдается потоку боев через очередь
+void tickThread(ThreadPool& pool) {
+    traceThreadName("tick");
+    Simulation simulation(game_world, pool);
+    simulation.setFightLimit(MAX_FIGHTS_PER_TICK);
+    simulation.indexWorld();
+    world_frames.publish(game_world, 0);
+
+    TickScheduler scheduler(simulation, [](std::uint32_t tick, const std::vector<FightTask>& fights) {
+        std::uint64_t kills_before = kill_count.load();
+        for (const auto& task : fights) {
+            fight_tasks.push(task);
         }
-        
-        if (!new_fights.empty()) {
-            std::lock_guard<std::mutex> lock(tasks_mutex);
-            fight_tasks.insert(fight_tasks.end(), new_fights.begin(), new_fights.end());
+        fight_tasks.push({END_OF_TICK, END_OF_TICK, tick});
+        queue_depth.set(static_cast<std::int64_t>(fight_tasks.depth()));
+
+        for (auto seen = resolved_tick.load(); seen < tick; seen = resolved_tick.load()) {
+            resolved_tick.wait(seen);
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+        // бои тика разобраны, а следующий move идет в этом же потоке: мир сейчас не меняется
+        world_frames.publish(game_world, tick);
+        return static_cast<std::size_t>(kill_count.load() - kills_before);
+    });
+
+    scheduler.runFixed(TICK_STEP, game_running);
 }
 
-void fightThread(const std::shared_ptr<IFFightObserver>& observer) {
-    while (game_running) {
-        std::vector<std::pair<std::shared_ptr<NPC>, std::shared_ptr<NPC>>> local_tasks;
-        
-        {
-            std::lock_guard<std::mutex> lock(tasks_mutex);
-            local_tasks.swap(fight_tasks);
+void fightThread(const std::shared_ptr<IFFightObserver>& observer, ThreadPool& fight_pool) {
+    traceThreadName("fights");
+    FightResolver resolver(fight_pool);
+    std::vector<FightTask> tick_fights;
+    FightTask task;
+    
+    // pop спит на atomic::wait, пока очередь пуста, и возвращает false после close()
+    while (fight_tasks.pop(task)) {
+        if (task.attacker != END_OF_TICK) {
+            tick_fights.push_back(task);
+            continue;
         }
-        
-        for (auto& [attacker, defender] : local_tasks) {
-            if (!attacker->isAlive() || !defender->isAlive()) continue;
-            
-            auto visitor = std::make_shared<FightVisitor>(attacker, observer);
-            bool canAttack = defender->accept(visitor);
-            
-            if (canAttack) {
-                auto [attack_power, defense_power] = attacker->rollDice();
-                
-                if (attack_power > defense_power) {
-                    defender->kill();
-                    
-                    std::unique_lock<std::shared_mutex> lock(game_world_mutex);
-                    game_world.erase(defender);
-                }
-            }
+
+        // бои тика целиком, пачками без общих нпс; без блокировки мира: убийство только
+        // помечает нпс, убирает их compact тика, а поток тиков не трогает мир, пока ждет
+        {
+            TRACE_SCOPE("resolve tick", "fight");
+            kill_count.fetch_add(resolver.resolve(game_world, tick_fights, observer));
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        tick_fights.clear();
+        resolved_tick.store(task.tick);
+        resolved_tick.notify_all();
     }
+
+    // тикам больше не нужно ждать
+    resolved_tick.store(UINT32_MAX);
+    resolved_tick.notify_all();
 }
 
-void renderThread() {
+void renderThread(int fps) {
+    traceThreadName("render");
+    const WorldConfig& config = worldConfig();
     auto start_time = std::chrono::steady_clock::now();
+    const auto frame_step = std::chrono::microseconds(1000000 / fps);
+
+    // клетка окна покрывает (width + 1) / display_width точек карты
+    const int display_width = static_cast<int>(std::min<long long>(VIEW_WIDTH, config.width + 1LL));
+    const int display_height = static_cast<int>(std::min<long long>(VIEW_HEIGHT, config.height + 1LL));
+    TerminalRenderer renderer(display_width, display_height, stdoutIsTerminal(), terminalRows());
+    const std::string legend = kindLegend();
+    std::string status;
+    double frame_ms = 0.0;
+    double max_frame_ms = 0.0;
+    Histogram& render_time = metrics().histogram("npc_tick_phase_ns", "Tick phase duration in nanoseconds",
+                                                 {"phase", "render"});
     
     while (game_running) {
         auto now = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - start_time).count();
         
-        if (elapsed >= GAME_DURATION) {
+        if (elapsed >= config.duration) {
             game_running = false;
             break;
         }
         
-        std::vector<std::string> map(MAP_HEIGHT, std::string(MAP_WIDTH, '.'));
-        int alive_count = 0;
-        
+        TRACE_SCOPE("frame", "render");
+        renderer.beginFrame();
+        std::uint32_t tick;
+        std::size_t alive_count;
         {
-            std::shared_lock<std::shared_mutex> lock(game_world_mutex);
-            
-            for (const auto& npc : game_world) {
-                if (npc->isAlive()) {
-                    alive_count++;
-                    int x = npc->getX();
-                    int y = npc->getY();
-                    
-                    if (x >= 0 && x < MAP_WIDTH && y >= 0 && y < MAP_HEIGHT) {
-                        char symbol = '.';
-                        std::string type = npc->getType();
-                        
-                        if (type == "Toad") symbol = 'T';
-                        else if (type == "Dragon") symbol = 'D';
-                        else if (type == "Knight") symbol = 'K';
-                        
-                        map[y][x] = symbol;
-                    }
-                }
+            // версия закреплена только на время прохода, тики не ждут отрисовку
+            auto frame = world_frames.read();
+            tick = frame->tick;
+            alive_count = frame->alive_count;
+            for (std::size_t id = 0; id < frame->size(); ++id) {
+                if (!frame->alive[id]) continue;
+                auto col = static_cast<long long>(frame->xs[id]) * display_width / (config.width + 1LL);
+                auto row = static_cast<long long>(frame->ys[id]) * display_height / (config.height + 1LL);
+                renderer.plot(static_cast<int>(col), static_cast<int>(row), typeSymbol(static_cast<NpcType>(frame->types[id])));
             }
         }
         
+        // время кадра показывается в следующем кадре
+        std::ostringstream line;
+        line << "--------- NPC BATTLE --------\n"
+             << "Time: " << elapsed << "/" << config.duration << "s | Tick: " << tick << " | Alive: " << alive_count
+             << " | Pending fights: " << fight_tasks.depth() << "\n"
+             << "Map: " << config.width << "x" << config.height
+             << std::fixed << std::setprecision(2)
+             << " | Frame: " << frame_ms << " ms (max " << max_frame_ms << ")"
+             << " | Changed cells: " << renderer.changedCells() << "\n"
+             << legend;
+        status = line.str();
+        
         {
-            std::lock_guard<std::mutex> lock(cout_mutex);
-            std::cout << "--------- NPC BATTLE --------" << std::endl;
-            std::cout << "Time: " << elapsed << "/" << GAME_DURATION << "s | Alive: " << alive_count 
-                      << " | Pending fights: " << fight_tasks.size() << std::endl;
-            std::cout << "Map: " << MAP_WIDTH << "x" << MAP_HEIGHT << std::endl;
-            std::cout << "T=Toad(1/10) D=Dragon(50/30) K=Knight(30/10)" << std::endl;
-            std::cout << std::endl;
-            
-            int display_height = std::min(30, MAP_HEIGHT);
-            int display_width = std::min(80, MAP_WIDTH);
-            
-            for (int y = 0; y < display_height; y++) {
-                for (int x = 0; x < display_width; x++) {
-                    std::cout << map[y][x];
-                }
-                std::cout << std::endl;
-            }
-            
-            std::cout << std::endl;
-            std::cout << "------------------------------" << std::endl;
+            std::unique_lock<std::mutex> lock(cout_mutex, std::defer_lock);
+            lockTraced(lock, "wait cout_mutex");
+            TRACE_SCOPE("write frame", "render");
+            writeFrame(renderer.finishFrame(status));
         }
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto frame_end = std::chrono::steady_clock::now();
+        frame_ms = std::chrono::duration<double, std::milli>(frame_end - now).count();
+        render_time.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(frame_end - now).count()));
+        max_frame_ms = std::max(max_frame_ms, frame_ms);
+        std::this_thread::sleep_until(now + frame_step);
     }
+
+    std::lock_guard<std::mutex> lock(cout_mutex);
+    writeFrame(renderer.close());
+}
+
+// без отрисовки и наблюдателей: тики подряд с максимальной скоростью
+int runHeadless(ThreadPool& pool, std::uint32_t ticks) {
+    Simulation simulation(game_world, pool);
+    simulation.setFightLimit(MAX_FIGHTS_PER_TICK);
+    simulation.indexWorld();
+
+    FightResolver resolver(pool);
+    TickScheduler scheduler(simulation, [&resolver](std::uint32_t, const std::vector<FightTask>& fights) {
+        return resolver.resolve(game_world, fights, nullptr);
+    });
+    RunStats stats = scheduler.runHeadless(ticks);
+
+    std::ostringstream out;
+    out << "Headless: " << stats.ticks << " ticks in " << stats.seconds << " s\n"
+        << "  ticks/sec:       " << stats.ticksPerSecond() << "\n"
+        << "  NPC updates/sec: " << stats.updatesPerSecond() << "\n"
+        << "  fights: " << stats.fights << " | kills: " << stats.kills
+        << " | survivors: " << game_world.aliveCount() << "/" << worldConfig().npc_count;
+    safePrint(out.str());
+    return 0;
 }
 
-int main() {
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+int main(int argc, char** argv) {
+    std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+    std::size_t workers = 0;
+    std::size_t fight_workers = 0;
+    bool headless = false;
+    std::uint32_t headless_ticks = 1000;
+    int fps = 1;
+    std::string metrics_path;
+    std::chrono::milliseconds metrics_interval{1000};
+    std::string trace_path;
+    std::string event_log_path;
+    WorldConfig config;
+    try {
+        // --config читается первым, флаги ниже переопределяют его значения
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::string(argv[i]) == "--config") {
+                std::ifstream file(argv[i + 1]);
+                if (!file) throw std::invalid_argument(std::string("Cannot open config ") + argv[i + 1]);
+                config = parseWorldConfig(file, config);
+            }
+        }
+        for (int i = 1; i + 1 < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--width" || arg == "--height" || arg == "--npcs" || arg == "--duration") {
+                setConfigValue(config, arg.substr(2), argv[++i]);
+            }
+        }
+        setWorldConfig(config);
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--headless") {
+                headless = true;
+            } else if (i + 1 < argc && arg == "--seed") {
+                seed = parseUnsigned(arg, argv[++i], UINT64_MAX);
+            } else if (i + 1 < argc && arg == "--workers") {
+                workers = parseUnsigned(arg, argv[++i], 1024);
+            } else if (i + 1 < argc && arg == "--fight-workers") {
+                fight_workers = parseUnsigned(arg, argv[++i], 1024);
+            } else if (i + 1 < argc && arg == "--ticks") {
+                headless_ticks = static_cast<std::uint32_t>(parseUnsigned(arg, argv[++i], UINT32_MAX));
+            } else if (i + 1 < argc && arg == "--fps") {
+                fps = static_cast<int>(std::clamp<unsigned long long>(parseUnsigned(arg, argv[++i], INT_MAX), 1, 60));
+            } else if (i + 1 < argc && arg == "--metrics") {
+                metrics_path = argv[++i];
+            } else if (i + 1 < argc && arg == "--metrics-interval") {
+                auto ms = std::max<unsigned long long>(10, parseUnsigned(arg, argv[++i], INT_MAX));
+                metrics_interval = std::chrono::milliseconds(static_cast<long long>(ms));
+            } else if (i + 1 < argc && arg == "--trace") {
+                trace_path = argv[++i];
+            } else if (i + 1 < argc && arg == "--event-log") {
+                event_log_path = argv[++i];
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    setRunSeed(seed);
+
+    // трасса пишется в файл при выходе из main, по обоим путям возврата
+    if (!trace_path.empty()) {
+#ifndef LAB7_TRACING
+        std::cerr << "Tracing is compiled out (LAB7_TRACING=OFF), the trace will be empty" << std::endl;
+#endif
+        startTracing();
+        traceThreadName("main");
+    }
+    auto finishTrace = [&trace_path] {
+        if (trace_path.empty()) return;
+        stopTracing();
+        if (!writeTraceFile(trace_path)) {
+            std::cerr << "Cannot write trace " << trace_path << std::endl;
+        }
+    };
+
+    // .json - JSON, иначе текст Prometheus; последняя выгрузка при выходе из main
+    std::unique_ptr<MetricsDumper> metrics_dumper;
+    if (!metrics_path.empty()) {
+        metrics_dumper = std::make_unique<MetricsDumper>(metrics(), metrics_path, metrics_interval,
+                                                         MetricsDumper::formatFor(metrics_path));
+    }
+
     safePrint("     Starting game...");
+    safePrint("Seed: " + std::to_string(seed));
 
     auto console_logger = std::make_shared<TextObserver>();
     {
-        std::unique_lock<std::shared_mutex> lock(game_world_mutex);
+        game_world.reserve(config.npc_count);
+        std::array<char, 64> name_buffer;
         
-        for (int i = 0; i < INITIAL_NPC_COUNT; ++i) {
-            NpcType type = static_cast<NpcType>(std::rand() % 3);
-            std::string name;
-            std::string type_name;
-            
-            switch (type) {
-                case NpcType::Toad:
-                    type_name = "Toad";
-                    break;
-                case NpcType::Dragon:
-                    type_name = "Dragon";
-                    break;
-                case NpcType::Knight:
-                    type_name = "Knight";
-                    break;
-            }
-            name = generateName(type_name, i);
+        for (std::size_t i = 0; i < config.npc_count; ++i) {
+            CounterRng spawn(seed, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+            NpcType type = static_cast<NpcType>(spawn.below(NPC_KIND_COUNT));
+            std::string_view name = generateName(typeName(type), i, name_buffer);
             
-            int x = std::rand() % MAP_WIDTH;
-            int y = std::rand() % MAP_HEIGHT;
+            int x = spawn.below(config.width);
+            int y = spawn.below(config.height);
             
-            auto npc = NPCFactory::create(type, name, x, y);
-            if (npc) {
-                game_world.insert(npc);
-            }
+            game_world.add(type, name, x, y);
         }
     }
     
-    safePrint("Created " + std::to_string(INITIAL_NPC_COUNT) + " NPCs");
-    safePrint("Game duration: " + std::to_string(GAME_DURATION) + " seconds");
-    safePrint("Map size: " + std::to_string(MAP_WIDTH) + "x" + std::to_string(MAP_HEIGHT));
+    safePrint("Created " + std::to_string(config.npc_count) + " NPCs");
+    safePrint("Map size: " + std::to_string(config.width) + "x" + std::to_string(config.height));
+    ThreadPool pool(workers);
+    safePrint("Workers: " + std::to_string(pool.size()));
+
+    if (headless) {
+        int code = runHeadless(pool, headless_ticks);
+        finishTrace();
+        return code;
+    }
+
+    // у потока боев свой пул: пул тиков принадлежит потоку тиков
+    ThreadPool fight_pool(fight_workers ? fight_workers : pool.size());
+    safePrint("Fight workers: " + std::to_string(fight_pool.size()));
+    safePrint("Game duration: " + std::to_string(config.duration) + " seconds");
     safePrint("Starting threads...");
     
-    std::thread movement_thread(movementThread);
-    std::thread fight_thread(fightThread, console_logger);
-    std::thread render_thread(renderThread);
+    std::shared_ptr<IFFightObserver> fight_observer = console_logger;
+    std::shared_ptr<BinaryLogObserver> event_log;
+    if (!event_log_path.empty()) {
+        try {
+            event_log = std::make_shared<BinaryLogObserver>(event_log_path, seed);
+        } catch (const std::exception& e) {
+            std::cerr << "Cannot open event log: " << e.what() << std::endl;
+            finishTrace();
+            return 1;
+        }
+        auto group = std::make_shared<ObserverGroup>();
+        group->add(console_logger);
+        group->add(event_log);
+        fight_observer = group;
+        safePrint("Event log: " + event_log_path);
+        if (event_log->droppedBytes() > 0) {
+            safePrint("Event log: cut torn tail of " + std::to_string(event_log->droppedBytes()) + " bytes");
+        }
+    }
+
+    std::thread tick_thread(tickThread, std::ref(pool));
+    std::thread fight_thread(fightThread, fight_observer, std::ref(fight_pool));
+    std::thread render_thread(renderThread, fps);
     
     // ждем завершения потока отрисовки 
     render_thread.join();
 
     game_running = false;
+    fight_tasks.close();
     
-    movement_thread.join();
+    tick_thread.join();
     fight_thread.join();
+    if (event_log) {
+        event_log->flush();
+        safePrint("Event log records: " + std::to_string(event_log->writtenCount()));
+    }
     
     safePrint("\n     --- GAME OVER ---     ");
-    safePrint("Survivors after " + std::to_string(GAME_DURATION) + " sec:");
+    safePrint("Survivors after " + std::to_string(config.duration) + " sec:");
     
     {
-        std::shared_lock<std::shared_mutex> lock(game_world_mutex);
+        std::lock_guard<std::mutex> out_lock(cout_mutex);
         int survivor_count = 0;
         
-        for (const auto& npc : game_world) {
-            if (npc->isAlive()) {
+        for (World::Id id = 0; id < game_world.size(); ++id) {
+            if (game_world.isAlive(id)) {
                 survivor_count++;
-                safePrint("  " + npc->getType() + " \"" + npc->getName() + 
-                          "\" at (" + std::to_string(npc->getX()) + 
-                          ", " + std::to_string(npc->getY()) + ")");
+                std::cout << "  " << typeName(game_world.getType(id)) << " \"" << game_world.getName(id)
+                          << "\" at (" << game_world.getX(id) << ", " << game_world.getY(id) << ")\n";
             }
         }
         
-        safePrint("Total survivors: " + std::to_string(survivor_count) + 
-                  "/" + std::to_string(INITIAL_NPC_COUNT));
+        std::cout << "Total survivors: " << survivor_count << "/" << config.npc_count << std::endl;
     }
+    finishTrace();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+
+#include "metrics.h"
+#include "trace.h"
+
+namespace {
+
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+const char* const QUANTILE_NAMES[] = {"p50", "p90", "p99", "p999"};
+
+void writeJsonString(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+}
+
+void Histogram::record(std::uint64_t value) {
+    buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::size_t Histogram::bucketOf(std::uint64_t value) {
+    if (value < 2 * SUB_BUCKETS) return static_cast<std::size_t>(value);
+    // value >> shift лежит в [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    int shift = std::bit_width(value) - (SUB_BUCKET_BITS + 1);
+    return 2 * SUB_BUCKETS + static_cast<std::size_t>(shift - 1) * SUB_BUCKETS +
+           static_cast<std::size_t>((value >> shift) - SUB_BUCKETS);
+}
+
+std::uint64_t Histogram::bucketUpper(std::size_t bucket) {
+    if (bucket < 2 * SUB_BUCKETS) return bucket;
+    std::size_t k = bucket - 2 * SUB_BUCKETS;
+    int shift = static_cast<int>(k / SUB_BUCKETS) + 1;
+    std::uint64_t sub = k % SUB_BUCKETS + SUB_BUCKETS;
+    // для последней корзины сдвиг переполняется в 0, и результат - UINT64_MAX
+    return ((sub + 1) << shift) - 1;
+}
+
+std::uint64_t Histogram::quantile(double q) const {
+    std::uint64_t total = count();
+    if (total == 0) return 0;
+    auto target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+    if (target == 0) target = 1;
+
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b].load(std::memory_order_relaxed);
+        if (seen >= target) return std::min(bucketUpper(b), max());
+    }
+    return max();
+}
+
+MetricsRegistry::Entry& MetricsRegistry::find(Kind kind, std::string_view name, std::string_view help,
+                                              MetricLabel label) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) {
+        if (entry->name != name) continue;
+        if (entry->kind != kind) {
+            throw std::invalid_argument("Metric " + std::string(name) + " already has another kind");
+        }
+        if (entry->label_key == label.key && entry->label_value == label.value) return *entry;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->kind = kind;
+    entry->name = name;
+    entry->help = help;
+    entry->label_key = label.key;
+    entry->label_value = label.value;
+    switch (kind) {
+        case Kind::Counter: entry->counter = std::make_unique<Counter>(); break;
+        case Kind::Gauge: entry->gauge = std::make_unique<Gauge>(); break;
+        case Kind::Histogram: entry->histogram = std::make_unique<Histogram>(); break;
+    }
+    entries.push_back(std::move(entry));
+    return *entries.back();
+}
+
+Counter& MetricsRegistry::counter(std::string_view name, std::string_view help, MetricLabel label) {
+    return *find(Kind::Counter, name, help, label).counter;
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name, std::string_view help, MetricLabel label) {
+    return *find(Kind::Gauge, name, help, label).gauge;
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name, std::string_view help, MetricLabel label) {
+    return *find(Kind::Histogram, name, help, label).histogram;
+}
+
+void MetricsRegistry::writeJson(std::ostream& out, double elapsed_seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "{\"timestamp\": " << std::time(nullptr) << ", \"metrics\": [";
+    bool first = true;
+    for (auto& entry : entries) {
+        out << (first ? "\n" : ",\n") << "  {\"name\": ";
+        first = false;
+        writeJsonString(out, entry->name);
+        if (!entry->label_key.empty()) {
+            out << ", \"labels\": {";
+            writeJsonString(out, entry->label_key);
+            out << ": ";
+            writeJsonString(out, entry->label_value);
+            out << "}";
+        }
+        switch (entry->kind) {
+            case Kind::Counter: {
+                std::uint64_t value = entry->counter->value();
+                double rate = elapsed_seconds > 0 ? static_cast<double>(value - entry->last_value) / elapsed_seconds : 0;
+                entry->last_value = value;
+                out << ", \"type\": \"counter\", \"value\": " << value << ", \"per_second\": " << rate << "}";
+                break;
+            }
+            case Kind::Gauge:
+                out << ", \"type\": \"gauge\", \"value\": " << entry->gauge->value() << "}";
+                break;
+            case Kind::Histogram: {
+                const Histogram& h = *entry->histogram;
+                out << ", \"type\": \"histogram\", \"count\": " << h.count() << ", \"sum\": " << h.sum()
+                    << ", \"max\": " << h.max();
+                for (std::size_t q = 0; q < std::size(QUANTILES); ++q) {
+                    out << ", \"" << QUANTILE_NAMES[q] << "\": " << h.quantile(QUANTILES[q]);
+                }
+                out << "}";
+                break;
+            }
+        }
+    }
+    out << "\n]}\n";
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    // метрики одного имени идут вместе под общими HELP и TYPE
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const Entry& head = *entries[i];
+        bool seen_before = false;
+        for (std::size_t j = 0; j < i && !seen_before; ++j) {
+            seen_before = entries[j]->name == head.name;
+        }
+        if (seen_before) continue;
+
+        const char* type = head.kind == Kind::Counter ? "counter" : head.kind == Kind::Gauge ? "gauge" : "summary";
+        out << "# HELP " << head.name << ' ' << head.help << '\n';
+        out << "# TYPE " << head.name << ' ' << type << '\n';
+
+        for (std::size_t j = i; j < entries.size(); ++j) {
+            const Entry& entry = *entries[j];
+            if (entry.name != head.name) continue;
+            std::string label;
+            if (!entry.label_key.empty()) label = entry.label_key + "=\"" + entry.label_value + "\"";
+
+            auto labels = [&](const std::string& extra) {
+                if (label.empty() && extra.empty()) return std::string();
+                return "{" + label + (label.empty() || extra.empty() ? "" : ",") + extra + "}";
+            };
+            switch (entry.kind) {
+                case Kind::Counter:
+                    out << entry.name << labels("") << ' ' << entry.counter->value() << '\n';
+                    break;
+                case Kind::Gauge:
+                    out << entry.name << labels("") << ' ' << entry.gauge->value() << '\n';
+                    break;
+                case Kind::Histogram: {
+                    const Histogram& h = *entry.histogram;
+                    for (double q : QUANTILES) {
+                        char quantile[32];
+                        std::snprintf(quantile, sizeof(quantile), "quantile=\"%g\"", q);
+                        out << entry.name << labels(quantile) << ' ' << h.quantile(q) << '\n';
+                    }
+                    out << entry.name << "_sum" << labels("") << ' ' << h.sum() << '\n';
+                    out << entry.name << "_count" << labels("") << ' ' << h.count() << '\n';
+                    break;
+                }
+            }
+        }
+    }
+}
+
+MetricsRegistry& metrics() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsDumper::MetricsDumper(MetricsRegistry& registry, std::string path, std::chrono::milliseconds interval,
+                             MetricsFormat format)
+    : registry(registry), path(std::move(path)), interval(interval), format(format),
+      last_dump(std::chrono::steady_clock::now()) {
+    worker = std::thread(&MetricsDumper::loop, this);
+}
+
+MetricsDumper::~MetricsDumper() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    dump();
+}
+
+MetricsFormat MetricsDumper::formatFor(std::string_view path) {
+    return path.size() >= 5 && path.substr(path.size() - 5) == ".json" ? MetricsFormat::Json
+                                                                       : MetricsFormat::Prometheus;
+}
+
+bool MetricsDumper::dump() {
+    TRACE_SCOPE("dump metrics", "metrics");
+    std::lock_guard<std::mutex> lock(dump_mutex);
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - last_dump).count();
+    last_dump = now;
+
+    // читатель файла не увидит его недописанным
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out) return false;
+        if (format == MetricsFormat::Json) {
+            registry.writeJson(out, elapsed);
+        } else {
+            registry.writePrometheus(out);
+        }
+        if (!out.flush()) return false;
+    }
+    return std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+void MetricsDumper::loop() {
+    traceThreadName("metrics");
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    while (!stopping) {
+        if (wake.wait_for(lock, interval, [this] { return stopping; })) break;
+        lock.unlock();
+        dump();
+        lock.lock();
+    }
+}
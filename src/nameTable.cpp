@@ -0,0 +1,52 @@
+#include "nameTable.h"
+
+#include <limits>
+#include <stdexcept>
+
+void NameTable::checkCapacity(std::size_t extra) const {
+    if (extra > std::numeric_limits<std::uint32_t>::max() - chars.size()) {
+        throw std::length_error("Name table exceeds 4 GB");
+    }
+}
+
+NameTable::NameId NameTable::add(std::string_view name) {
+    checkCapacity(name.size());
+    NameId id = static_cast<NameId>(size());
+    chars.insert(chars.end(), name.begin(), name.end());
+    offsets.push_back(static_cast<std::uint32_t>(chars.size()));
+    return id;
+}
+
+NameTable::NameId NameTable::addPacked(std::size_t n, const char* packed, const std::uint32_t* packed_offsets) {
+    std::size_t total = packed_offsets[n] - packed_offsets[0];
+    checkCapacity(total);
+
+    NameId first = static_cast<NameId>(size());
+    auto base = static_cast<std::uint32_t>(chars.size()) - packed_offsets[0];
+    chars.insert(chars.end(), packed + packed_offsets[0], packed + packed_offsets[n]);
+    offsets.reserve(offsets.size() + n);
+    for (std::size_t i = 1; i <= n; ++i) {
+        offsets.push_back(base + packed_offsets[i]);
+    }
+    return first;
+}
+
+void NameTable::compact(std::vector<NameId>& ids) {
+    std::vector<char> kept;
+    std::vector<std::uint32_t> kept_offsets;
+    kept_offsets.reserve(ids.size() + 1);
+    kept_offsets.push_back(0);
+    for (NameId& id : ids) {
+        std::string_view name = get(id);
+        kept.insert(kept.end(), name.begin(), name.end());
+        kept_offsets.push_back(static_cast<std::uint32_t>(kept.size()));
+        id = static_cast<NameId>(kept_offsets.size() - 2);
+    }
+    chars.swap(kept);
+    offsets.swap(kept_offsets);
+}
+
+void NameTable::reserve(std::size_t names, std::size_t bytes) {
+    offsets.reserve(names + 1);
+    chars.reserve(bytes);
+}
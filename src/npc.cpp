@@ -1,23 +1,35 @@
 #include <cmath>
-#include <cstdlib>
-#include <ctime>
+#include <cstdint>
+#include <stdexcept>
 
 #include "npc.h"
+#include "fightVisitor.h"
+#include "worldConfig.h"
+#include "registry.h"
 
-NPC::NPC(const std::string& name, int x, int y) 
-    : name(name), x(x), y(y), alive(true) {
-    if (x < 0 || x > 100 || y < 0 || y > 100) {
-        throw std::runtime_error("NPC coordinates must be in range 0-100");
+NPC::NPC(NpcType type, const std::string& name, int x, int y) 
+    : type(type), name(name), x(x), y(y), alive(true) {
+    if (!worldConfig().contains(x, y)) {
+        throw std::runtime_error("NPC coordinates must be inside the map");
     }
 }
 
-void NPC::moveRandom() {
-    if (!alive) return;  
-    
-    int dx = (rand() % 3) - 1;  // -1, 0, или 1
-    int dy = (rand() % 3) - 1;  // -1, 0, или 1
+std::string_view NPC::getType() const {
+    return typeName(type);
+}
+
+char NPC::getSymbol() const {
+    return typeSymbol(type);
+}
+
+bool NPC::accept(const std::shared_ptr<FightVisitor>& attacker) {
+    return attacker->visit(shared_from_this());
+}
+
+void randomStep(int& x, int& y, int move_dist, CounterRng& rng) {
+    int dx = rng.below(3) - 1;  // -1, 0, или 1
+    int dy = rng.below(3) - 1;  // -1, 0, или 1
     
-    int move_dist = getMoveDist();
     if (move_dist > 0) {
         dx *= move_dist;
         dy *= move_dist;
@@ -26,19 +38,38 @@ void NPC::moveRandom() {
     int newX = x + dx;
     int newY = y + dy;
 
-    if (newX >= 0 && newX <= 100 && newY >= 0 && newY <= 100) {
+    if (worldConfig().contains(newX, newY)) {
         x = newX;
         y = newY;
     }
 }
 
+void NPC::moveRandom() {
+    moveRandom(threadRng());
+}
+
+void NPC::moveRandom(CounterRng& rng) {
+    if (!alive) return;  
+    randomStep(x, y, getMoveDist(), rng);
+}
+
 std::pair<int, int> NPC::rollDice() const {
-    return {std::rand() % 6 + 1, std::rand() % 6 + 1};
+    return rollDice(threadRng());
+}
+
+std::pair<int, int> NPC::rollDice(CounterRng& rng) const {
+    return ::rollDice(rng);
+}
+
+std::pair<int, int> rollDice(CounterRng& rng) {
+    int attack = rng.below(6) + 1;
+    int defense = rng.below(6) + 1;
+    return {attack, defense};
 }
 
 double NPC::distance(const std::shared_ptr<NPC>& other) const {
     if (!other) return 0;
-    int dx = x - other->x;
-    int dy = y - other->y;
-    return std::sqrt(dx * dx + dy * dy);
+    std::int64_t dx = x - other->x;
+    std::int64_t dy = y - other->y;
+    return std::sqrt(static_cast<double>(dx * dx + dy * dy));
 }
\ No newline at end of file
@@ -1,8 +1,37 @@
 #include "observer.h"
+#include "registry.h"
+#include "trace.h"
+
+namespace {
+
+void printKill(std::ostream& os, const FightEvent& event) {
+    os << typeName(event.attacker.type) << " " << event.attacker.name << " killed "
+       << typeName(event.defender.type) << " " << event.defender.name
+       << " at (" << event.defender.x << ", " << event.defender.y << ")\n";
+}
+
+}
+
+void IFFightObserver::onFightEvent(const FightEvent& event) {
+    auto attacker = makeNpc(event.attacker.type, std::string(event.attacker.name), event.attacker.x, event.attacker.y);
+    auto defender = makeNpc(event.defender.type, std::string(event.defender.name), event.defender.x, event.defender.y);
+    onFight(attacker, defender, event.killed);
+}
+
+FightEvent makeEvent(const NPC& attacker, const NPC& defender, bool success) {
+    return {{attacker.getTypeTag(), attacker.getName(), attacker.getX(), attacker.getY()},
+            {defender.getTypeTag(), defender.getName(), defender.getX(), defender.getY()},
+            success, 0, success};
+}
 
 void TextObserver::onFight(const std::shared_ptr<NPC>& attacker,const std::shared_ptr<NPC>& defender,bool success) {
-    if (success) {
-        std::cout << attacker->getType() << " " << attacker->getName() << " killed " << defender->getType() << " " << defender->getName() << " at (" << defender->getX() << ", " << defender->getY() << ")\n";
+    onFightEvent(makeEvent(*attacker, *defender, success));
+}
+
+void TextObserver::onFightEvent(const FightEvent& event) {
+    if (event.killed) {
+        TRACE_SCOPE("text observer", "observer");
+        printKill(std::cout, event);
     }
 }
 
@@ -17,9 +46,24 @@ FileObserver::~FileObserver() {
 }
 
 void FileObserver::onFight(const std::shared_ptr<NPC>& attacker,const std::shared_ptr<NPC>& defender, bool success) {
-    if (logfile.is_open() && success) {
-        logfile << attacker->getType() << " " << attacker->getName() 
-                << " killed " << defender->getType() << " " << defender->getName() 
-                << " at (" << defender->getX() << ", " << defender->getY() << ")\n";
+    onFightEvent(makeEvent(*attacker, *defender, success));
+}
+
+void FileObserver::onFightEvent(const FightEvent& event) {
+    if (logfile.is_open() && event.killed) {
+        TRACE_SCOPE("file observer", "observer");
+        printKill(logfile, event);
+    }
+}
+
+void ObserverGroup::onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) {
+    for (const auto& observer : observers) {
+        observer->onFight(attacker, defender, success);
     }
-}
\ No newline at end of file
+}
+
+void ObserverGroup::onFightEvent(const FightEvent& event) {
+    for (const auto& observer : observers) {
+        observer->onFightEvent(event);
+    }
+}
@@ -0,0 +1,162 @@
+#include "renderer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char EMPTY_CELL = '.';
+const std::string_view SEPARATOR = "------------------------------";
+
+}
+
+TerminalRenderer::TerminalRenderer(int width, int height, bool ansi, int terminal_rows)
+    : width(width), height(height), ansi(ansi), terminal_rows(terminal_rows),
+      current(static_cast<std::size_t>(width) * height, EMPTY_CELL),
+      previous(current.size(), EMPTY_CELL) {
+    // худший случай - полная перерисовка с позиционированием каждой строки
+    buffer.reserve(current.size() + static_cast<std::size_t>(height + STATUS_LINES) * 16 + 1024);
+}
+
+void TerminalRenderer::beginFrame() {
+    std::fill(current.begin(), current.end(), EMPTY_CELL);
+}
+
+void TerminalRenderer::appendInt(int value) {
+    char digits[16];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, res.ptr);
+}
+
+void TerminalRenderer::moveTo(int row, int col) {
+    buffer += "\x1b[";
+    appendInt(row);
+    buffer += ';';
+    appendInt(col);
+    buffer += 'H';
+}
+
+std::string_view TerminalRenderer::finishFrame(std::string_view status) {
+    buffer.clear();
+    if (ansi) {
+        renderAnsi(status);
+    } else {
+        renderPlain(status);
+    }
+    previous.swap(current);
+    full_redraw = false;
+    return buffer;
+}
+
+void TerminalRenderer::renderPlain(std::string_view status) {
+    changed = current.size();
+    buffer += status;
+    if (!status.empty() && status.back() != '\n') buffer += '\n';
+    buffer += '\n';
+    for (int row = 0; row < height; ++row) {
+        buffer.append(&current[static_cast<std::size_t>(row) * width], width);
+        buffer += '\n';
+    }
+    buffer += '\n';
+    buffer += SEPARATOR;
+    buffer += '\n';
+}
+
+void TerminalRenderer::renderAnsi(std::string_view status) {
+    if (full_redraw) {
+        // очистка, область прокрутки журнала под картой, курсор журнала в ее начало
+        buffer += "\x1b[2J";
+        if (logTop() < terminal_rows) {
+            buffer += "\x1b[";
+            appendInt(logTop());
+            buffer += ';';
+            appendInt(terminal_rows);
+            buffer += 'r';
+        }
+        moveTo(std::min(logTop(), terminal_rows), 1);
+    }
+    buffer += "\x1b" "7";  // сохранить курсор журнала
+
+    // статус переписывается всегда, хвост строки стирается
+    int line = 0;
+    while (line < STATUS_LINES) {
+        std::size_t end = status.find('\n');
+        moveTo(line + 1, 1);
+        buffer += status.substr(0, end);
+        buffer += "\x1b[K";
+        ++line;
+        status.remove_prefix(end == std::string_view::npos ? status.size() : end + 1);
+    }
+
+    changed = 0;
+    for (int row = 0; row < height; ++row) {
+        const char* now = &current[static_cast<std::size_t>(row) * width];
+        const char* before = &previous[static_cast<std::size_t>(row) * width];
+        int col = 0;
+        while (col < width) {
+            if (!full_redraw && now[col] == before[col]) {
+                ++col;
+                continue;
+            }
+            // подряд идущие изменения - одно позиционирование
+            int run = col;
+            while (run < width && (full_redraw || now[run] != before[run])) ++run;
+            moveTo(mapTop() + row, col + 1);
+            buffer.append(now + col, run - col);
+            changed += static_cast<std::size_t>(run - col);
+            col = run;
+        }
+    }
+    if (full_redraw) {
+        moveTo(mapTop() + height, 1);
+        buffer += SEPARATOR;
+    }
+
+    buffer += "\x1b" "8";  // вернуть курсор журнала
+}
+
+std::string_view TerminalRenderer::close() {
+    buffer.clear();
+    if (ansi) {
+        buffer += "\x1b[r";
+        moveTo(terminal_rows, 1);
+        buffer += '\n';
+    }
+    return buffer;
+}
+
+void writeFrame(std::string_view frame) {
+    std::fflush(stdout);  // сначала то, что уже лежит в буфере stdio
+#if defined(__unix__) || defined(__APPLE__)
+    while (!frame.empty()) {
+        ssize_t written = ::write(STDOUT_FILENO, frame.data(), frame.size());
+        if (written <= 0) return;
+        frame.remove_prefix(static_cast<std::size_t>(written));
+    }
+#else
+    std::fwrite(frame.data(), 1, frame.size(), stdout);
+    std::fflush(stdout);
+#endif
+}
+
+bool stdoutIsTerminal() {
+#if defined(__unix__) || defined(__APPLE__)
+    return ::isatty(STDOUT_FILENO) == 1;
+#else
+    return false;
+#endif
+}
+
+int terminalRows(int fallback) {
+#if defined(__unix__) || defined(__APPLE__)
+    winsize size{};
+    if (::ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) return size.ws_row;
+#endif
+    return fallback;
+}
@@ -0,0 +1,60 @@
+#include <atomic>
+
+#include "rng.h"
+
+namespace {
+
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+std::atomic<std::uint64_t> run_seed{0};
+std::atomic<std::uint32_t> thread_counter{0};
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+    std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+}
+
+std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < 10; ++round) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, ctr[0], hi0, lo0);
+        mulhilo(PHILOX_M1, ctr[2], hi1, lo1);
+        ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return ctr;
+}
+
+void setRunSeed(std::uint64_t seed) {
+    run_seed.store(seed, std::memory_order_relaxed);
+}
+
+std::uint64_t runSeed() {
+    return run_seed.load(std::memory_order_relaxed);
+}
+
+CounterRng::CounterRng(std::uint64_t seed, RngStream stream, std::uint32_t tick, std::uint32_t a, std::uint32_t b)
+    : counter{tick, a, b, 0},
+      key{static_cast<std::uint32_t>(seed) ^ (static_cast<std::uint32_t>(stream) * PHILOX_W0),
+          static_cast<std::uint32_t>(seed >> 32)} {}
+
+std::uint32_t CounterRng::next() {
+    if (used == 4) {
+        block = philox4x32(counter, key);
+        ++counter[3];
+        used = 0;
+    }
+    return block[used++];
+}
+
+CounterRng& threadRng() {
+    thread_local CounterRng rng(runSeed(), RngStream::Local, 0, thread_counter.fetch_add(1));
+    return rng;
+}
@@ -0,0 +1,119 @@
+#include <mutex>
+#include <thread>
+
+#include "scheduler.h"
+#include "trace.h"
+
+namespace {
+
+const char* const PHASE_HELP = "Tick phase duration in nanoseconds";
+
+std::uint64_t nanosSince(std::chrono::steady_clock::time_point& since) {
+    auto now = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - since).count();
+    since = now;
+    return static_cast<std::uint64_t>(ns);
+}
+
+}
+
+TickScheduler::TickScheduler(Simulation& simulation, Resolver resolve, std::shared_mutex* world_mutex)
+    : simulation(simulation), resolve(std::move(resolve)), world_mutex(world_mutex),
+      move_time(metrics().histogram("npc_tick_phase_ns", PHASE_HELP, {"phase", "move"})),
+      detect_time(metrics().histogram("npc_tick_phase_ns", PHASE_HELP, {"phase", "detect"})),
+      resolve_time(metrics().histogram("npc_tick_phase_ns", PHASE_HELP, {"phase", "resolve"})),
+      compact_time(metrics().histogram("npc_tick_phase_ns", PHASE_HELP, {"phase", "compact"})),
+      ticks_total(metrics().counter("npc_ticks_total", "Simulation ticks")),
+      updates_total(metrics().counter("npc_updates_total", "Moves of living NPCs")),
+      fights_total(metrics().counter("npc_fights_total", "Fights found by detection")),
+      capped_ticks(metrics().counter("npc_fight_capped_ticks_total", "Ticks whose detection hit the fight limit")),
+      alive(metrics().gauge("npc_alive", "Living NPCs after the last tick")) {}
+
+void TickScheduler::step(RunStats& stats) {
+    ++tick;
+    fights.clear();
+    auto phase_start = std::chrono::steady_clock::now();
+
+    // ожидание блокировки мира видно в трассе отдельно от самой фазы
+    std::size_t moved;
+    {
+        TRACE_SCOPE("move", "tick");
+        std::unique_lock<std::shared_mutex> lock;
+        if (world_mutex) {
+            lock = std::unique_lock<std::shared_mutex>(*world_mutex, std::defer_lock);
+            lockTraced(lock, "wait game_world_mutex");
+        }
+        moved = simulation.move(tick);
+    }
+    move_time.record(nanosSince(phase_start));
+
+    {
+        TRACE_SCOPE("detect", "tick");
+        std::shared_lock<std::shared_mutex> lock;
+        if (world_mutex) {
+            lock = std::shared_lock<std::shared_mutex>(*world_mutex, std::defer_lock);
+            lockTraced(lock, "wait game_world_mutex");
+        }
+        simulation.detect(tick, fights);
+        if (simulation.lastDetectCapped()) capped_ticks.add();
+    }
+    detect_time.record(nanosSince(phase_start));
+
+    {
+        TRACE_SCOPE("resolve", "tick");
+        stats.kills += resolve(tick, fights);
+    }
+    resolve_time.record(nanosSince(phase_start));
+
+    {
+        TRACE_SCOPE("compact", "tick");
+        std::unique_lock<std::shared_mutex> lock;
+        if (world_mutex) {
+            lock = std::unique_lock<std::shared_mutex>(*world_mutex, std::defer_lock);
+            lockTraced(lock, "wait game_world_mutex");
+        }
+        simulation.compact();
+    }
+    compact_time.record(nanosSince(phase_start));
+
+    stats.npc_updates += moved;
+    stats.fights += fights.size();
+    ++stats.ticks;
+    updates_total.add(moved);
+    fights_total.add(fights.size());
+    ticks_total.add();
+    // после compact в сетке только живые
+    alive.set(static_cast<std::int64_t>(simulation.getGrid().size()));
+}
+
+RunStats TickScheduler::runFixed(std::chrono::milliseconds step_time, const std::atomic<bool>& running) {
+    RunStats stats;
+    auto start = std::chrono::steady_clock::now();
+    auto next = start;
+
+    while (running) {
+        step(stats);
+
+        // отставшие тики не догоняются пачкой, отсчет начинается заново
+        next += step_time;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now;
+        } else {
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+RunStats TickScheduler::runHeadless(std::uint32_t ticks) {
+    RunStats stats;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < ticks; ++i) {
+        step(stats);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
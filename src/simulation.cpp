@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <array>
+
+#include "simulation.h"
+#include "fightVisitor.h"
+#include "metrics.h"
+#include "registry.h"
+#include "rng.h"
+
+namespace {
+
+// счетчики убийств по виду атакующего; регистрируются до main, чтобы бой не выделял память
+std::array<Counter*, NPC_KIND_COUNT> registerKillCounters() {
+    std::array<Counter*, NPC_KIND_COUNT> counters{};
+    for (std::size_t kind = 0; kind < NPC_KIND_COUNT; ++kind) {
+        counters[kind] = &metrics().counter("npc_kills_total", "Kills by attacker species", {"species", KIND_INFO[kind].name});
+    }
+    return counters;
+}
+
+const std::array<Counter*, NPC_KIND_COUNT> KILL_COUNTERS = registerKillCounters();
+
+}
+
+Simulation::Simulation(World& world, ThreadPool& pool)
+    : world(world), pool(pool), grid(MAX_KIND_KILL_DIST),
+      relocations(TILE_COUNT), moved_counts(TILE_COUNT), found(TILE_COUNT), scratch(TILE_COUNT) {}
+
+void Simulation::indexWorld() {
+    grid.clear();
+    for (World::Id id = 0; id < world.size(); ++id) {
+        if (world.isAlive(id)) {
+            grid.insert(id, world.getX(id), world.getY(id));
+        }
+    }
+}
+
+World::Id Simulation::spawn(NpcType type, std::string_view name, int x, int y) {
+    World::Id id = world.spawn(type, name, x, y);
+    grid.insert(id, x, y);
+    return id;
+}
+
+std::size_t Simulation::move(std::uint32_t tick) {
+    grid.sortedCells(cells);
+
+    // каждый нпс лежит ровно в одной ячейке, поэтому тайлы пишут в разные элементы мира
+    pool.parallelFor(TILE_COUNT, [&](std::size_t tile) {
+        auto& moved = relocations[tile];
+        moved.clear();
+        std::size_t count = 0;
+        for (std::size_t c = tileBegin(tile); c < tileEnd(tile); ++c) {
+            for (World::Id id : *cells[c].ids) {
+                int old_x = world.getX(id);
+                int old_y = world.getY(id);
+                world.moveRandom(id, tick);
+                ++count;
+                int new_x = world.getX(id);
+                int new_y = world.getY(id);
+                if (!grid.sameCell(old_x, old_y, new_x, new_y)) {
+                    moved.push_back({id, old_x, old_y, new_x, new_y});
+                }
+            }
+        }
+        moved_counts[tile] = count;
+    });
+
+    std::size_t total = 0;
+    for (std::size_t count : moved_counts) {
+        total += count;
+    }
+
+    for (const auto& moved : relocations) {
+        for (const auto& r : moved) {
+            grid.move(r.id, r.old_x, r.old_y, r.new_x, r.new_y);
+        }
+    }
+    return total;
+}
+
+std::size_t Simulation::compact() {
+    removed.clear();
+    grid.removeIf([&](World::Id id) { return !world.isAlive(id); }, removed);
+
+    // задачи тика уже разобраны, на слоты ссылается только сетка:
+    // переехавшие в дыры живые переименовываются в своих ячейках
+    world.compact(slot_moves);
+    for (const auto& move : slot_moves) {
+        grid.rename(move.from, move.to, world.getX(move.to), world.getY(move.to));
+    }
+    return removed.size();
+}
+
+void Simulation::detect(std::uint32_t tick, std::vector<FightTask>& out) {
+    grid.sortedCells(cells);
+
+    pool.parallelFor(TILE_COUNT, [&](std::size_t tile) {
+        auto& fights = found[tile];
+        fights.clear();
+        for (std::size_t c = tileBegin(tile); c < tileEnd(tile) && fights.size() < fight_limit; ++c) {
+            const std::vector<SpatialGrid::Id>* neighbors[4];
+            std::size_t neighbor_count = grid.forwardNeighbors(cells[c].cx, cells[c].cy, neighbors);
+            detectCell(world, *cells[c].ids, neighbors, neighbor_count, tick, scratch[tile], fights);
+        }
+    });
+
+    // склейка в порядке тайлов совпадает с последовательным обходом; тайл, бросивший поиск,
+    // уже дал не меньше предела, поэтому первые fight_limit боев те же, что без предела
+    detect_capped = false;
+    std::size_t start = out.size();
+    for (const auto& fights : found) {
+        std::size_t room = fight_limit - (out.size() - start);
+        if (fights.size() >= room) {
+            out.insert(out.end(), fights.begin(), fights.begin() + static_cast<std::ptrdiff_t>(room));
+            detect_capped = true;
+            break;
+        }
+        out.insert(out.end(), fights.begin(), fights.end());
+    }
+}
+
+bool resolveFight(World& world, const FightTask& task, const std::shared_ptr<IFFightObserver>& observer) {
+    if (!world.isAlive(task.attacker) || !world.isAlive(task.defender)) return false;
+
+    bool killed = false;
+    if (canKill(world.getType(task.attacker), world.getType(task.defender))) {
+        CounterRng dice(runSeed(), RngStream::Dice, task.tick, world.getUid(task.attacker), world.getUid(task.defender));
+        auto [attack_power, defense_power] = rollDice(dice);
+        if (attack_power > defense_power) {
+            world.kill(task.defender);
+            KILL_COUNTERS[static_cast<std::size_t>(world.getType(task.attacker))]->add();
+            killed = true;
+        }
+    }
+
+    // событие уходит после броска, чтобы наблюдатель видел настоящий исход.
+    // Без фасадов и shared_ptr: ни выделений памяти, ни атомарных счетчиков на бой
+    if (observer) WorldFightVisitor(world, observer.get()).visit(task.attacker, task.defender, task.tick, killed);
+    return killed;
+}
+
+std::size_t resolveFights(World& world, const std::vector<FightTask>& tasks,
+                          const std::shared_ptr<IFFightObserver>& observer) {
+    std::size_t kills = 0;
+    for (const auto& task : tasks) {
+        if (resolveFight(world, task, observer)) ++kills;
+    }
+    return kills;
+}
@@ -0,0 +1,61 @@
+#include "slabResource.h"
+
+#include <thread>
+
+SlabResource::SlabResource(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+
+SlabResource::~SlabResource() {
+    for (void* slab : slabs) {
+        upstream->deallocate(slab, SLAB_BYTES, GRANULE);
+    }
+}
+
+void SlabResource::lock() {
+    while (busy.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void* SlabResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_BLOCK || alignment > GRANULE) {
+        return upstream->allocate(bytes, alignment);
+    }
+    std::size_t cls = (bytes + GRANULE - 1) / GRANULE - (bytes != 0);
+    std::size_t size = (cls + 1) * GRANULE;
+
+    lock();
+    if (FreeBlock* block = free_lists[cls]) {
+        free_lists[cls] = block->next;
+        unlock();
+        return block;
+    }
+    if (cursor == nullptr || static_cast<std::size_t>(slab_end - cursor) < size) {
+        try {
+            slabs.reserve(slabs.size() + 1);
+            cursor = static_cast<char*>(upstream->allocate(SLAB_BYTES, GRANULE));
+        } catch (...) {
+            unlock();
+            throw;
+        }
+        slabs.push_back(cursor);
+        slab_end = cursor + SLAB_BYTES;
+    }
+    void* result = cursor;
+    cursor += size;
+    unlock();
+    return result;
+}
+
+void SlabResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_BLOCK || alignment > GRANULE) {
+        upstream->deallocate(p, bytes, alignment);
+        return;
+    }
+    std::size_t cls = (bytes + GRANULE - 1) / GRANULE - (bytes != 0);
+
+    lock();
+    auto* block = static_cast<FreeBlock*>(p);
+    block->next = free_lists[cls];
+    free_lists[cls] = block;
+    unlock();
+}
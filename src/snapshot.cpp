@@ -0,0 +1,185 @@
+#include "snapshot.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "registry.h"
+#include "worldConfig.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_HAS_MMAP 1
+#endif
+
+static_assert(std::endian::native == std::endian::little, "Snapshot format is little-endian");
+static_assert(sizeof(int) == sizeof(std::int32_t), "World coordinates are stored as int32");
+static_assert(sizeof(SnapshotHeader) == 80, "Snapshot header layout changed");
+
+namespace {
+
+const std::size_t COLUMN_ALIGN = 64;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + COLUMN_ALIGN - 1) / COLUMN_ALIGN * COLUMN_ALIGN;
+}
+
+void writeColumn(std::ofstream& out, std::uint64_t offset, const void* bytes, std::size_t size) {
+    static const char zeros[COLUMN_ALIGN] = {};
+    auto pos = static_cast<std::uint64_t>(out.tellp());
+    out.write(zeros, static_cast<std::streamsize>(offset - pos));
+    out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+}
+
+[[noreturn]] void corrupted(const std::string& what) {
+    throw std::runtime_error("Corrupted snapshot: " + what);
+}
+
+}
+
+void saveSnapshot(const World& world, const std::string& path) {
+    const std::size_t n = world.size();
+
+    std::vector<std::uint32_t> name_offsets(n + 1);
+    std::string names;
+    for (World::Id id = 0; id < n; ++id) {
+        name_offsets[id] = static_cast<std::uint32_t>(names.size());
+        names += world.getName(id);
+        if (names.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("Snapshot names exceed 4 GB");
+        }
+    }
+    name_offsets[n] = static_cast<std::uint32_t>(names.size());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.header_size = sizeof(SnapshotHeader);
+    header.count = n;
+    header.types_offset = alignUp(sizeof(SnapshotHeader));
+    header.alive_offset = alignUp(header.types_offset + n);
+    header.xs_offset = alignUp(header.alive_offset + n);
+    header.ys_offset = alignUp(header.xs_offset + n * sizeof(std::int32_t));
+    header.name_offsets_offset = alignUp(header.ys_offset + n * sizeof(std::int32_t));
+    header.names_offset = alignUp(header.name_offsets_offset + (n + 1) * sizeof(std::uint32_t));
+    header.names_size = names.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open snapshot for writing: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeColumn(out, header.types_offset, world.getTypes().data(), n);
+    writeColumn(out, header.alive_offset, world.getAlive().data(), n);
+    writeColumn(out, header.xs_offset, world.getXs().data(), n * sizeof(std::int32_t));
+    writeColumn(out, header.ys_offset, world.getYs().data(), n * sizeof(std::int32_t));
+    writeColumn(out, header.name_offsets_offset, name_offsets.data(), name_offsets.size() * sizeof(std::uint32_t));
+    writeColumn(out, header.names_offset, names.data(), names.size());
+    if (!out) {
+        throw std::runtime_error("Failed to write snapshot: " + path);
+    }
+}
+
+SnapshotView::SnapshotView(const std::string& path) {
+#ifdef SNAPSHOT_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open snapshot: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat snapshot: " + path);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length > 0) {
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map snapshot: " + path);
+        }
+        data = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open snapshot: " + path);
+    }
+    fallback.assign(std::istreambuf_iterator<char>(in), {});
+    data = fallback.data();
+    length = fallback.size();
+#endif
+
+    try {
+        validate();
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+SnapshotView::~SnapshotView() {
+    unmap();
+}
+
+void SnapshotView::unmap() {
+#ifdef SNAPSHOT_HAS_MMAP
+    if (data) {
+        ::munmap(const_cast<char*>(data), length);
+        data = nullptr;
+    }
+#endif
+}
+
+void SnapshotView::validate() {
+    if (length < sizeof(SnapshotHeader)) corrupted("file is shorter than header");
+    header = reinterpret_cast<const SnapshotHeader*>(data);
+
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) corrupted("bad magic");
+    if (header->version != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header->version));
+    }
+    if (header->header_size != sizeof(SnapshotHeader)) corrupted("bad header size");
+
+    const std::uint64_t n = header->count;
+    auto fits = [&](std::uint64_t offset, std::uint64_t bytes) {
+        return offset % alignof(std::uint32_t) == 0 && offset <= length && bytes <= length - offset;
+    };
+    if (n > length || !fits(header->types_offset, n) || !fits(header->alive_offset, n) ||
+        !fits(header->xs_offset, n * sizeof(std::int32_t)) || !fits(header->ys_offset, n * sizeof(std::int32_t)) ||
+        !fits(header->name_offsets_offset, (n + 1) * sizeof(std::uint32_t)) ||
+        !fits(header->names_offset, header->names_size)) {
+        corrupted("column out of bounds");
+    }
+
+    const std::uint8_t* kinds = types();
+    const std::uint32_t* offsets = nameOffsets();
+    if (offsets[0] != 0 || offsets[n] != header->names_size) corrupted("bad name offsets");
+    for (std::uint64_t i = 0; i < n; ++i) {
+        if (!isValidType(static_cast<NpcType>(kinds[i]))) corrupted("unknown NPC type");
+        if (offsets[i] > offsets[i + 1]) corrupted("bad name offsets");
+    }
+}
+
+void SnapshotView::appendTo(World& world) const {
+    const WorldConfig& config = worldConfig();
+    const std::int32_t* x = xs();
+    const std::int32_t* y = ys();
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (!config.contains(x[i], y[i])) {
+            corrupted("NPC coordinates must be inside the map");
+        }
+    }
+    world.reserve(world.size() + size());
+    world.append(size(), types(), alive(), x, y, names(), nameOffsets());
+}
+
+void loadSnapshot(const std::string& path, World& world) {
+    SnapshotView(path).appendTo(world);
+}
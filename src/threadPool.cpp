@@ -0,0 +1,93 @@
+#include <algorithm>
+
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(std::size_t workers) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < workers; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (std::size_t i = 1; i < workers; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stopping.store(true);
+    work_signal.fetch_add(1);
+    work_signal.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool ThreadPool::runOne(std::size_t self) {
+    std::function<void()> task;
+
+    // своя очередь - с конца (горячие данные), чужие - с начала
+    {
+        auto& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    for (std::size_t i = 1; !task && i < queues.size(); ++i) {
+        auto& victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) return false;
+
+    task();
+    if (pending.fetch_sub(1) == 1) {
+        pending.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    while (!stopping.load()) {
+        std::uint32_t seen = work_signal.load();
+        if (runOne(self)) continue;
+        work_signal.wait(seen);
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) return;
+    if (queues.size() == 1) {
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    pending.fetch_add(count);
+    // подряд идущие индексы - в одну очередь, чтобы соседние тайлы шли одному потоку
+    std::size_t per_queue = (count + queues.size() - 1) / queues.size();
+    for (std::size_t q = 0; q < queues.size(); ++q) {
+        auto& queue = *queues[q];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        std::size_t begin = q * per_queue;
+        std::size_t end = std::min(count, begin + per_queue);
+        // своя очередь разбирается с конца, поэтому кладем в обратном порядке
+        for (std::size_t i = end; i > begin; --i) {
+            queue.tasks.push_back([&fn, i] { fn(i - 1); });
+        }
+    }
+    work_signal.fetch_add(1);
+    work_signal.notify_all();
+
+    while (runOne(0)) {}
+    for (std::size_t left = pending.load(); left != 0; left = pending.load()) {
+        pending.wait(left);
+    }
+}
@@ -0,0 +1,185 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "trace.h"
+
+namespace {
+
+// лимит спанов на поток: 32 байта на спан, не больше 32 МБ
+const std::size_t MAX_SPANS_PER_THREAD = 1 << 20;
+
+struct Span {
+    const char* name;
+    const char* category;
+    std::uint64_t start_ns;
+    std::uint64_t end_ns;
+};
+
+// буфер пишет только его поток; спин-замок берет еще лишь выгрузка
+struct ThreadTrace {
+    std::uint32_t tid = 0;
+    std::string name;
+    std::atomic_flag busy;
+    std::vector<Span> spans;
+    std::uint64_t dropped = 0;
+
+    void lock() {
+        while (busy.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+    void unlock() { busy.clear(std::memory_order_release); }
+};
+
+struct Tracer {
+    std::atomic<bool> enabled{false};
+    std::atomic<std::int64_t> origin_ns{0};
+    std::mutex mutex;
+    // буферы завершившихся потоков остаются здесь до выгрузки
+    std::vector<std::shared_ptr<ThreadTrace>> threads;
+};
+
+Tracer& tracer() {
+    static Tracer instance;
+    return instance;
+}
+
+std::int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ThreadTrace& localTrace() {
+    thread_local std::shared_ptr<ThreadTrace> mine = [] {
+        auto trace = std::make_shared<ThreadTrace>();
+        Tracer& t = tracer();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        trace->tid = static_cast<std::uint32_t>(t.threads.size() + 1);
+        t.threads.push_back(trace);
+        return trace;
+    }();
+    return *mine;
+}
+
+void writeJsonString(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+}
+
+void startTracing() {
+    Tracer& t = tracer();
+    {
+        std::lock_guard<std::mutex> lock(t.mutex);
+        for (auto& thread : t.threads) {
+            thread->lock();
+            thread->spans.clear();
+            thread->dropped = 0;
+            thread->unlock();
+        }
+    }
+    t.origin_ns.store(steadyNs(), std::memory_order_relaxed);
+    t.enabled.store(true, std::memory_order_release);
+}
+
+void stopTracing() {
+    tracer().enabled.store(false, std::memory_order_release);
+}
+
+bool tracingEnabled() {
+    return tracer().enabled.load(std::memory_order_relaxed);
+}
+
+std::uint64_t traceNow() {
+    return static_cast<std::uint64_t>(steadyNs() - tracer().origin_ns.load(std::memory_order_relaxed));
+}
+
+void traceSpan(const char* name, const char* category, std::uint64_t start_ns, std::uint64_t end_ns) {
+    ThreadTrace& trace = localTrace();
+    trace.lock();
+    if (trace.spans.size() < MAX_SPANS_PER_THREAD) {
+        trace.spans.push_back({name, category, start_ns, end_ns});
+    } else {
+        ++trace.dropped;
+    }
+    trace.unlock();
+}
+
+void traceThreadName(const std::string& name) {
+    ThreadTrace& trace = localTrace();
+    trace.lock();
+    trace.name = name;
+    trace.unlock();
+}
+
+void writeTrace(std::ostream& out) {
+    Tracer& t = tracer();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    char number[64];
+    for (auto& thread : t.threads) {
+        thread->lock();
+        if (!thread->name.empty()) {
+            out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                << thread->tid << ", \"args\": {\"name\": ";
+            writeJsonString(out, thread->name);
+            out << "}}";
+            first = false;
+        }
+        for (const Span& span : thread->spans) {
+            // ts и dur - микросекунды, дробная часть сохраняет наносекунды
+            std::snprintf(number, sizeof(number), "\"ts\": %.3f, \"dur\": %.3f", span.start_ns / 1000.0,
+                          (span.end_ns - span.start_ns) / 1000.0);
+            out << (first ? "\n" : ",\n") << "{\"name\": ";
+            writeJsonString(out, span.name);
+            out << ", \"cat\": ";
+            writeJsonString(out, span.category);
+            out << ", \"ph\": \"X\", " << number << ", \"pid\": 1, \"tid\": " << thread->tid << "}";
+            first = false;
+        }
+        thread->unlock();
+    }
+    out << "\n]}\n";
+}
+
+bool writeTraceFile(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    writeTrace(out);
+    return static_cast<bool>(out.flush());
+}
+
+std::uint64_t traceSpanCount() {
+    Tracer& t = tracer();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    std::uint64_t total = 0;
+    for (auto& thread : t.threads) {
+        thread->lock();
+        total += thread->spans.size();
+        thread->unlock();
+    }
+    return total;
+}
+
+std::uint64_t traceDroppedCount() {
+    Tracer& t = tracer();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    std::uint64_t total = 0;
+    for (auto& thread : t.threads) {
+        thread->lock();
+        total += thread->dropped;
+        thread->unlock();
+    }
+    return total;
+}
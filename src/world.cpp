@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "world.h"
+#include "registry.h"
+
+World::World() : facade_pool(std::make_unique<SlabResource>()) {}
+
+World::Id World::add(const NPC& npc) {
+    Id id = static_cast<Id>(xs.size());
+    xs.push_back(npc.getX());
+    ys.push_back(npc.getY());
+    types.push_back(static_cast<std::uint8_t>(npc.getTypeTag()));
+    alive.push_back(npc.isAlive() ? 1 : 0);
+    move_dists.push_back(npc.getMoveDist());
+    kill_dists.push_back(npc.getKillDist());
+    name_ids.push_back(names.add(npc.getName()));
+    uids.push_back(next_uid++);
+    return id;
+}
+
+World::Id World::add(NpcType type, std::string_view name, int x, int y, bool is_alive) {
+    if (!isValidType(type)) {
+        throw std::invalid_argument("Unknown NPC type");
+    }
+    const KindInfo& info = kindInfo(type);
+    Id id = static_cast<Id>(xs.size());
+    xs.push_back(x);
+    ys.push_back(y);
+    types.push_back(static_cast<std::uint8_t>(type));
+    alive.push_back(is_alive ? 1 : 0);
+    move_dists.push_back(info.move_dist);
+    kill_dists.push_back(info.kill_dist);
+    name_ids.push_back(names.add(name));
+    uids.push_back(next_uid++);
+    return id;
+}
+
+void World::append(std::size_t n, const std::uint8_t* new_types, const std::uint8_t* new_alive,
+                   const std::int32_t* new_xs, const std::int32_t* new_ys, const char* new_names,
+                   const std::uint32_t* name_offsets) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!isValidType(static_cast<NpcType>(new_types[i]))) {
+            throw std::invalid_argument("Unknown NPC type");
+        }
+    }
+
+    xs.insert(xs.end(), new_xs, new_xs + n);
+    ys.insert(ys.end(), new_ys, new_ys + n);
+    types.insert(types.end(), new_types, new_types + n);
+    NameTable::NameId first = names.addPacked(n, new_names, name_offsets);
+    for (std::size_t i = 0; i < n; ++i) {
+        alive.push_back(new_alive[i] ? 1 : 0);
+        const KindInfo& info = kindInfo(static_cast<NpcType>(new_types[i]));
+        move_dists.push_back(info.move_dist);
+        kill_dists.push_back(info.kill_dist);
+        name_ids.push_back(first + static_cast<NameTable::NameId>(i));
+        uids.push_back(next_uid++);
+    }
+}
+
+void World::reserve(std::size_t n) {
+    xs.reserve(n);
+    ys.reserve(n);
+    types.reserve(n);
+    alive.reserve(n);
+    move_dists.reserve(n);
+    kill_dists.reserve(n);
+    name_ids.reserve(n);
+    uids.reserve(n);
+}
+
+void World::release(Id id) {
+    if (id >= alive.size() || alive[id]) return;
+    // флаги дорастают до размера мира только здесь: add про них не знает
+    if (released.size() < alive.size()) released.resize(alive.size(), 0);
+    if (released[id]) return;
+    released[id] = 1;
+    free_ids.push_back(id);
+}
+
+void World::compact() {
+    std::vector<SlotMove> moved;
+    compact(moved);
+}
+
+void World::compact(std::vector<SlotMove>& moved) {
+    moved.clear();
+    std::size_t n = alive.size();
+    std::size_t hole = 0;
+    for (;;) {
+        while (n > 0 && !alive[n - 1]) {
+            --n;
+            stale_name_bytes += names.get(name_ids[n]).size();
+        }
+        while (hole < n && alive[hole]) ++hole;
+        if (hole >= n) break;
+
+        // живой с конца занимает дыру; он уже за новым концом, поэтому второй раз не переедет
+        Id from = static_cast<Id>(n - 1);
+        stale_name_bytes += names.get(name_ids[hole]).size();
+        xs[hole] = xs[from];
+        ys[hole] = ys[from];
+        types[hole] = types[from];
+        alive[hole] = 1;
+        move_dists[hole] = move_dists[from];
+        kill_dists[hole] = kill_dists[from];
+        name_ids[hole] = name_ids[from];
+        uids[hole] = uids[from];
+        moved.push_back({from, static_cast<Id>(hole)});
+        --n;
+    }
+    free_ids.clear();  // мертвых не осталось
+    released.clear();
+    if (n == alive.size()) return;
+
+    xs.resize(n);
+    ys.resize(n);
+    types.resize(n);
+    alive.resize(n);
+    move_dists.resize(n);
+    kill_dists.resize(n);
+    name_ids.resize(n);
+    uids.resize(n);
+    reclaimNames();
+
+    if (n < xs.capacity() / 2) {
+        xs.shrink_to_fit();
+        ys.shrink_to_fit();
+        types.shrink_to_fit();
+        alive.shrink_to_fit();
+        move_dists.shrink_to_fit();
+        kill_dists.shrink_to_fit();
+        name_ids.shrink_to_fit();
+        uids.shrink_to_fit();
+    }
+}
+
+World::Id World::spawn(NpcType type, std::string_view name, int x, int y) {
+    if (free_ids.empty()) {
+        return add(type, name, x, y);
+    }
+    if (!isValidType(type)) {
+        throw std::invalid_argument("Unknown NPC type");
+    }
+
+    Id id = free_ids.back();
+    free_ids.pop_back();
+    released[id] = 0;
+    const KindInfo& info = kindInfo(type);
+    xs[id] = x;
+    ys[id] = y;
+    types[id] = static_cast<std::uint8_t>(type);
+    alive[id] = 1;
+    move_dists[id] = info.move_dist;
+    kill_dists[id] = info.kill_dist;
+    stale_name_bytes += names.get(name_ids[id]).size();
+    name_ids[id] = names.add(name);
+    uids[id] = next_uid++;
+    reclaimNames();
+    return id;
+}
+
+void World::reclaimNames() {
+    // пересборка линейна по живой части таблицы, поэтому только при половине мусора:
+    // на каждый байт нового имени приходится O(1) работы, а память не растет без предела
+    if (stale_name_bytes == 0 || stale_name_bytes * 2 < names.bytes()) return;
+    names.compact(name_ids);
+    stale_name_bytes = 0;
+}
+
+std::size_t World::aliveCount() const {
+    return static_cast<std::size_t>(std::count(alive.begin(), alive.end(), std::uint8_t{1}));
+}
+
+void World::moveRandom(Id id, std::uint32_t tick) {
+    if (!alive[id]) return;
+    CounterRng rng(runSeed(), RngStream::Move, tick, uids[id]);
+    randomStep(xs[id], ys[id], move_dists[id], rng);
+}
+
+double World::distance(Id a, Id b) const {
+    std::int64_t dx = xs[a] - xs[b];
+    std::int64_t dy = ys[a] - ys[b];
+    return std::sqrt(static_cast<double>(dx * dx + dy * dy));
+}
+
+int World::maxKillDist() const {
+    int result = 1;
+    for (int dist : kill_dists) {
+        result = std::max(result, dist);
+    }
+    return result;
+}
+
+std::shared_ptr<NPC> World::npc(Id id) const {
+    std::pmr::polymorphic_allocator<NPC> alloc(facade_pool.get());
+    auto result = allocateNpc(alloc, getType(id), std::string(getName(id)), xs[id], ys[id]);
+    if (result && !alive[id]) {
+        result->kill();
+    }
+    return result;
+}
@@ -0,0 +1,106 @@
+#include "worldConfig.h"
+
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+WorldConfig active_config;
+
+long long parseNumber(const std::string& key, const std::string& value) {
+    std::size_t used = 0;
+    long long result;
+    try {
+        result = std::stoll(value, &used);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Config value for " + key + " is not a number: " + value);
+    }
+    if (used != value.size()) {
+        throw std::invalid_argument("Config value for " + key + " is not a number: " + value);
+    }
+    return result;
+}
+
+// проверки пределов до сужения в int, чтобы большое значение не обернулось в допустимое
+void checkSide(long long side) {
+    if (side < 1 || side > WorldConfig::MAX_SIDE) {
+        throw std::invalid_argument("Map size must be in range 1-" + std::to_string(WorldConfig::MAX_SIDE));
+    }
+}
+
+void checkDuration(long long duration) {
+    if (duration < 0) {
+        throw std::invalid_argument("Game duration must not be negative");
+    }
+    if (duration > INT_MAX) {
+        throw std::invalid_argument("Game duration must not exceed " + std::to_string(INT_MAX) + " seconds");
+    }
+}
+
+std::string trim(const std::string& s) {
+    const char* spaces = " \t\r";
+    std::size_t begin = s.find_first_not_of(spaces);
+    if (begin == std::string::npos) return {};
+    return s.substr(begin, s.find_last_not_of(spaces) - begin + 1);
+}
+
+}
+
+void WorldConfig::validate() const {
+    checkSide(width);
+    checkSide(height);
+    checkDuration(duration);
+}
+
+void setWorldConfig(const WorldConfig& config) {
+    config.validate();
+    active_config = config;
+}
+
+const WorldConfig& worldConfig() {
+    return active_config;
+}
+
+bool setConfigValue(WorldConfig& config, const std::string& key, const std::string& value) {
+    if (key == "width" || key == "height") {
+        long long side = parseNumber(key, value);
+        checkSide(side);
+        (key == "width" ? config.width : config.height) = static_cast<int>(side);
+    } else if (key == "npcs") {
+        long long count = parseNumber(key, value);
+        if (count < 0) throw std::invalid_argument("NPC count must not be negative");
+        config.npc_count = static_cast<std::size_t>(count);
+    } else if (key == "duration") {
+        long long duration = parseNumber(key, value);
+        checkDuration(duration);
+        config.duration = static_cast<int>(duration);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+WorldConfig parseWorldConfig(std::istream& is, WorldConfig base) {
+    std::string line;
+    std::size_t line_no = 0;
+    while (std::getline(is, line)) {
+        ++line_no;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::invalid_argument("Config line " + std::to_string(line_no) + ": expected key = value");
+        }
+        std::string key = trim(line.substr(0, eq));
+        try {
+            if (!setConfigValue(base, key, trim(line.substr(eq + 1)))) {
+                throw std::invalid_argument("unknown key " + key);
+            }
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Config line " + std::to_string(line_no) + ": " + e.what());
+        }
+    }
+    base.validate();
+    return base;
+}
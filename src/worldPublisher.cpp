@@ -0,0 +1,40 @@
+#include "worldPublisher.h"
+
+WorldPublisher::ReadGuard WorldPublisher::read() const {
+    for (;;) {
+        std::uint32_t index = current.load();
+        const Slot& slot = slots[index];
+        slot.readers.fetch_add(1);
+        // слот мог перестать быть текущим до закрепления: тогда писатель
+        // уже может в него писать, берем новый текущий
+        if (current.load() == index) {
+            return ReadGuard(&slot);
+        }
+        slot.readers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool WorldPublisher::publish(const World& world, std::uint32_t tick) {
+    std::uint32_t now = current.load(std::memory_order_relaxed);
+    for (std::uint32_t step = 1; step < SLOTS; ++step) {
+        std::uint32_t index = (now + step) % SLOTS;
+        Slot& slot = slots[index];
+        // не текущий слот новых читателей не получает, поэтому ноль здесь окончательный
+        if (slot.readers.load() != 0) continue;
+
+        WorldFrame& frame = slot.frame;
+        frame.tick = tick;
+        // assign переиспользует емкость прошлых версий
+        frame.xs.assign(world.getXs().begin(), world.getXs().end());
+        frame.ys.assign(world.getYs().begin(), world.getYs().end());
+        frame.types.assign(world.getTypes().begin(), world.getTypes().end());
+        frame.alive.assign(world.getAlive().begin(), world.getAlive().end());
+        frame.alive_count = world.aliveCount();
+
+        current.store(index);
+        published_count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    skipped_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
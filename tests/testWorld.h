@@ -0,0 +1,25 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+#include "registry.h"
+#include "rng.h"
+#include "world.h"
+
+// случайный мир для тестов: виды и координаты из потока Spawn зерна seed,
+// координаты в [0, side), имена "N<номер>" различны
+inline World makeWorld(int count, std::uint32_t seed, int side = 101) {
+    World world;
+    char name[16] = {'N'};
+    for (int i = 0; i < count; ++i) {
+        CounterRng rng(seed, RngStream::Spawn, 0, static_cast<std::uint32_t>(i));
+        auto type = static_cast<NpcType>(rng.below(NPC_KIND_COUNT));
+        int x = rng.below(side);
+        int y = rng.below(side);
+        char* end = std::to_chars(name + 1, name + sizeof(name), i).ptr;
+        world.add(type, std::string_view(name, static_cast<std::size_t>(end - name)), x, y);
+    }
+    return world;
+}
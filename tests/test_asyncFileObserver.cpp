@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asyncFileObserver.h"
+#include "dragon.h"
+#include "knight.h"
+#include "toad.h"
+
+namespace {
+
+const char* LOG = "test_async_log.txt";
+
+std::string readAll(const char* path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+std::size_t countLines(const std::string& text) {
+    std::size_t lines = 0;
+    for (char c : text) lines += c == '\n';
+    return lines;
+}
+
+class AsyncFileObserverTest : public ::testing::Test {
+protected:
+    void SetUp() override { std::remove(LOG); }
+    void TearDown() override { std::remove(LOG); }
+};
+
+}
+
+TEST_F(AsyncFileObserverTest, WritesSameLineAsFileObserver) {
+    auto attacker = std::make_shared<Toad>("AttackerToad", 10, 20);
+    auto defender = std::make_shared<Dragon>("DefenderDragon", 30, 40);
+    {
+        AsyncFileObserver observer(LOG);
+        observer.onFight(attacker, defender, true);
+        observer.onFight(attacker, defender, false);
+    }
+    EXPECT_EQ(readAll(LOG), "Toad AttackerToad killed Dragon DefenderDragon at (30, 40)\n");
+}
+
+TEST_F(AsyncFileObserverTest, FlushesEverythingOnShutdown) {
+    auto attacker = std::make_shared<Knight>("K", 1, 1);
+    auto defender = std::make_shared<Dragon>("D", 2, 2);
+    const std::size_t events = 10000;
+    {
+        // длинный интервал: без сброса в деструкторе файл остался бы пустым
+        AsyncFileObserver observer(LOG, {64, std::chrono::seconds(10), OverflowPolicy::Block});
+        for (std::size_t i = 0; i < events; ++i) {
+            observer.onFight(attacker, defender, true);
+        }
+    }
+    EXPECT_EQ(countLines(readAll(LOG)), events);
+}
+
+TEST_F(AsyncFileObserverTest, BlockPolicyLosesNothingUnderContention) {
+    auto attacker = std::make_shared<Knight>("K", 1, 1);
+    auto defender = std::make_shared<Dragon>("D", 2, 2);
+    const std::size_t per_thread = 2000;
+    const std::size_t threads = 4;
+    {
+        AsyncFileObserver observer(LOG, {16, std::chrono::milliseconds(1), OverflowPolicy::Block});
+        std::vector<std::thread> producers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            producers.emplace_back([&] {
+                for (std::size_t i = 0; i < per_thread; ++i) observer.onFight(attacker, defender, true);
+            });
+        }
+        for (auto& p : producers) p.join();
+        EXPECT_EQ(observer.droppedCount(), 0u);
+    }
+    EXPECT_EQ(countLines(readAll(LOG)), per_thread * threads);
+}
+
+TEST_F(AsyncFileObserverTest, DropPolicyCountsDroppedRecords) {
+    auto attacker = std::make_shared<Knight>("K", 1, 1);
+    auto defender = std::make_shared<Dragon>("D", 2, 2);
+    const std::size_t events = 5000;
+    std::uint64_t dropped;
+    {
+        AsyncFileObserver observer(LOG, {4, std::chrono::seconds(10), OverflowPolicy::Drop});
+        for (std::size_t i = 0; i < events; ++i) observer.onFight(attacker, defender, true);
+        dropped = observer.droppedCount();
+    }
+    // записанные + отброшенные = все события
+    EXPECT_EQ(countLines(readAll(LOG)) + dropped, events);
+}
+
+// имена длиннее записи пишутся целиком, строка та же, что у FileObserver
+TEST_F(AsyncFileObserverTest, KeepsLongNames) {
+    std::string long_name(100, 'x');
+    std::string edge_name(FightRecord::NAME_CAP - 1, 'e');
+    auto attacker = std::make_shared<Toad>(long_name, 1, 1);
+    auto defender = std::make_shared<Toad>(std::string(FightRecord::NAME_CAP, 'y'), 2, 2);
+    auto edge = std::make_shared<Toad>(edge_name, 3, 3);
+    {
+        AsyncFileObserver observer(LOG);
+        observer.onFight(attacker, defender, true);
+        observer.onFight(edge, defender, true);
+    }
+    std::string text = readAll(LOG);
+    EXPECT_EQ(text, "Toad " + long_name + " killed Toad " + std::string(FightRecord::NAME_CAP, 'y') + " at (2, 2)\n" +
+                    "Toad " + edge_name + " killed Toad " + std::string(FightRecord::NAME_CAP, 'y') + " at (2, 2)\n");
+}
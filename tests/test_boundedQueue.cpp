@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "boundedQueue.h"
+
+TEST(BoundedQueueTest, FifoSingleThread) {
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_EQ(queue.depth(), 4);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_EQ(queue.depth(), 0);
+}
+
+TEST(BoundedQueueTest, CapacityRoundsUpAndFullRejects) {
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_THROW(BoundedQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedQueueTest, PopWaitsForPush) {
+    BoundedQueue<int> queue(8);
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(42);
+    });
+
+    int value = 0;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 42);
+    producer.join();
+}
+
+TEST(BoundedQueueTest, CloseWakesConsumer) {
+    BoundedQueue<int> queue(8);
+    std::thread consumer([&] {
+        int value;
+        EXPECT_FALSE(queue.pop(value));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    consumer.join();
+
+    EXPECT_FALSE(queue.push(1));
+}
+
+// несколько производителей, один потребитель: каждый элемент ровно один раз
+TEST(BoundedQueueTest, MultiProducerDeliversEverything) {
+    const int producers = 4;
+    const int per_producer = 20000;
+    BoundedQueue<int> queue(64);  // маленькая, чтобы производители упирались
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+
+    std::vector<int> seen(producers * per_producer, 0);
+    std::vector<int> last(producers, -1);
+    for (int n = 0; n < producers * per_producer; ++n) {
+        int value;
+        ASSERT_TRUE(queue.pop(value));
+        seen[value]++;
+        // порядок внутри одного производителя сохраняется
+        int p = value / per_producer;
+        EXPECT_GT(value, last[p]);
+        last[p] = value;
+    }
+    for (auto& t : threads) t.join();
+
+    for (int count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_EQ(queue.depth(), 0);
+}
+
+TEST(BoundedQueueTest, FullQueueCountsStall) {
+    BoundedQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_EQ(queue.producerStalls(), 0u);
+
+    std::thread producer([&] { EXPECT_TRUE(queue.push(3)); });
+    while (queue.producerStalls() == 0) {
+        std::this_thread::yield();
+    }
+
+    int value;
+    ASSERT_TRUE(queue.pop(value));
+    producer.join();
+    EXPECT_EQ(queue.producerStalls(), 1u);
+    EXPECT_EQ(queue.depth(), 2);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "detect.h"
+#include "toad.h"
+#include "dragon.h"
+#include "knight.h"
+
+TEST(DetectTest, ScalarMasks) {
+    // нпс в (0, 0) с радиусом 10
+    int xs[] = {6, 8, 20, 0};
+    int ys[] = {8, 8, 0, 30};
+    int kills[] = {10, 10, 30, 10};
+
+    KillMasks m = killRangeMasksScalar(0, 0, 10, xs, ys, kills, 4);
+    EXPECT_EQ(m.by_self, 0b0001u);   // ровно 10 - еще в радиусе
+    EXPECT_EQ(m.by_other, 0b0101u);  // дальнобойный кандидат достает
+}
+
+TEST(DetectTest, HugeDistancesDoNotOverflow) {
+    int xs[] = {100000, -100000};
+    int ys[] = {100000, 0};
+    int kills[] = {30, 30};
+    KillMasks m = killRangeMasks(0, 0, 30, xs, ys, kills, 2);
+    EXPECT_EQ(m.by_self, 0u);
+    EXPECT_EQ(m.by_other, 0u);
+}
+
+// векторный вариант должен совпадать со скалярным на любых длинах блока
+TEST(DetectTest, DispatchedMatchesScalar) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> coord(-50, 150);
+    std::uniform_int_distribution<int> kill(0, 40);
+
+    for (std::size_t n = 0; n <= KILL_BLOCK; ++n) {
+        std::vector<int> xs(n), ys(n), kills(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = coord(gen);
+            ys[i] = coord(gen);
+            kills[i] = kill(gen);
+        }
+        int x = coord(gen), y = coord(gen), k = kill(gen);
+
+        KillMasks expected = killRangeMasksScalar(x, y, k, xs.data(), ys.data(), kills.data(), n);
+        KillMasks actual = killRangeMasks(x, y, k, xs.data(), ys.data(), kills.data(), n);
+        EXPECT_EQ(expected.by_self, actual.by_self) << "n=" << n << " kernel=" << killRangeKernelName();
+        EXPECT_EQ(expected.by_other, actual.by_other) << "n=" << n << " kernel=" << killRangeKernelName();
+    }
+}
+
+// поиск боев через сетку находит те же пары, что и полный перебор
+TEST(DetectTest, DetectFightsMatchesBruteForce) {
+    std::srand(11);
+    World world;
+    for (int i = 0; i < 300; ++i) {
+        int x = std::rand() % 101;
+        int y = std::rand() % 101;
+        switch (i % 3) {
+            case 0: world.add(Toad("T", x, y)); break;
+            case 1: world.add(Dragon("D", x, y)); break;
+            default: world.add(Knight("K", x, y)); break;
+        }
+    }
+    world.kill(5);
+
+    SpatialGrid grid(world.maxKillDist());
+    for (World::Id id = 0; id < world.size(); ++id) {
+        grid.insert(id, world.getX(id), world.getY(id));
+    }
+
+    std::vector<FightTask> fights;
+    detectFights(world, grid, 0, fights);
+
+    std::set<std::pair<World::Id, World::Id>> found;
+    for (auto [attacker, defender, tick] : fights) {
+        EXPECT_EQ(tick, 0u);
+        EXPECT_LE(world.distance(attacker, defender), world.getKillDist(attacker));
+        EXPECT_TRUE(found.insert({std::min(attacker, defender), std::max(attacker, defender)}).second);
+    }
+
+    std::size_t expected = 0;
+    for (World::Id a = 0; a < world.size(); ++a) {
+        for (World::Id b = a + 1; b < world.size(); ++b) {
+            if (!world.isAlive(a) || !world.isAlive(b)) continue;
+            double d = world.distance(a, b);
+            if (d <= world.getKillDist(a) || d <= world.getKillDist(b)) {
+                ++expected;
+                EXPECT_EQ(found.count({a, b}), 1);
+            }
+        }
+    }
+    EXPECT_EQ(found.size(), expected);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "eventLog.h"
+#include "fightVisitor.h"
+#include "simulation.h"
+#include "testWorld.h"
+
+namespace {
+
+const std::string PATH = "test_events.bin";
+
+EventRecord record(std::uint32_t tick, std::uint32_t attacker, std::uint32_t defender, NpcType type, bool success) {
+    return {tick, attacker, defender, 1, 2, static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(NpcType::Toad),
+            static_cast<std::uint8_t>(success ? 1 : 0), static_cast<std::uint8_t>(success ? 1 : 0)};
+}
+
+class EventLogTest : public ::testing::Test {
+protected:
+    void SetUp() override { std::remove(PATH.c_str()); }
+    void TearDown() override { std::remove(PATH.c_str()); }
+};
+
+}
+
+TEST_F(EventLogTest, KillsPerSpeciesByWindow) {
+    {
+        EventLogWriter writer(PATH);
+        // больше блока, чтобы часть окон считалась по индексу, часть по записям
+        for (std::uint32_t i = 0; i < 3 * EVENT_BLOCK_RECORDS; ++i) {
+            std::uint32_t tick = i / 100;
+            writer.append(record(tick, i, i + 1, i % 2 ? NpcType::Dragon : NpcType::Knight, i % 3 != 0));
+        }
+    }
+
+    EventLogReader reader(PATH);
+    auto all = killsPerSpecies(reader, 0, UINT32_MAX, 0);
+    ASSERT_EQ(all.size(), 1u);
+    std::uint64_t total = 0;
+    for (auto k : all[0].kills) total += k;
+    EXPECT_EQ(total, 2u * EVENT_BLOCK_RECORDS);
+    EXPECT_EQ(all[0].kills[static_cast<std::size_t>(NpcType::Toad)], 0u);
+
+    // тики 10..19 и 20..29: по 1000 записей, из них убийств 666 или 667
+    auto windows = killsPerSpecies(reader, 10, 29, 10);
+    ASSERT_EQ(windows.size(), 2u);
+    EXPECT_EQ(windows[0].from_tick, 10u);
+    EXPECT_EQ(windows[1].from_tick, 20u);
+    std::uint64_t first = 0;
+    for (auto k : windows[0].kills) first += k;
+    std::uint64_t expected = 0;
+    for (std::uint32_t i = 1000; i < 2000; ++i) expected += i % 3 != 0;
+    EXPECT_EQ(first, expected);
+    EXPECT_FALSE(reader.truncated());
+}
+
+// uid и тики в каждом запуске свои: запросы не смешивают сессии
+TEST_F(EventLogTest, QueriesStayInOneSession) {
+    {
+        EventLogWriter writer(PATH, 11);
+        writer.append(record(1, 5, 6, NpcType::Dragon, true));
+        writer.append(record(2, 7, 8, NpcType::Knight, false));
+    }
+    {
+        EventLogWriter writer(PATH, 22);
+        writer.append(record(1, 9, 5, NpcType::Toad, true));
+    }
+
+    EventLogReader reader(PATH);
+    ASSERT_EQ(reader.sessions().size(), 2u);
+    EXPECT_EQ(reader.sessions()[0].seed, 11u);
+    EXPECT_EQ(reader.sessions()[0].records, 2u);
+    EXPECT_EQ(reader.sessions()[1].seed, 22u);
+    EXPECT_EQ(reader.sessions()[1].records, 1u);
+    EXPECT_GT(reader.sessions()[1].start_ms, 0u);
+
+    // по умолчанию последняя сессия
+    EXPECT_EQ(reader.selectedSession(), 1u);
+    auto history = npcHistory(reader, 5);
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history[0].attacker, 9u);
+    auto kills = killsPerSpecies(reader, 0, UINT32_MAX, 0);
+    ASSERT_EQ(kills.size(), 1u);
+    EXPECT_EQ(kills[0].kills[static_cast<std::size_t>(NpcType::Toad)], 1u);
+    EXPECT_EQ(kills[0].kills[static_cast<std::size_t>(NpcType::Dragon)], 0u);
+
+    reader.selectSession(0);
+    history = npcHistory(reader, 5);
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history[0].defender, 6u);
+    EXPECT_THROW(reader.selectSession(2), std::out_of_range);
+}
+
+TEST_F(EventLogTest, TruncatedTailIsSkipped) {
+    {
+        EventLogWriter writer(PATH);
+        writer.append(record(1, 1, 2, NpcType::Dragon, true));
+        writer.flush();
+        writer.append(record(2, 1, 3, NpcType::Dragon, true));
+    }
+    // запись второго блока оборвалась посередине
+    std::ifstream in(PATH, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(PATH, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 10));
+
+    EventLogReader reader(PATH);
+    EXPECT_EQ(npcHistory(reader, 1).size(), 1u);
+    EXPECT_TRUE(reader.truncated());
+}
+
+// новая сессия отрезает обрезанный хвост прошлой, и ее блоки читаются
+TEST_F(EventLogTest, ReopenCutsTornTail) {
+    {
+        EventLogWriter writer(PATH);
+        writer.append(record(1, 1, 2, NpcType::Dragon, true));
+        writer.flush();
+        writer.append(record(2, 1, 3, NpcType::Dragon, true));
+    }
+    std::ifstream in(PATH, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(PATH, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 10));
+
+    {
+        EventLogWriter writer(PATH);
+        EXPECT_EQ(writer.droppedBytes(), sizeof(EventBlockHeader) + sizeof(EventRecord) - 10);
+        writer.append(record(3, 4, 1, NpcType::Knight, true));
+    }
+
+    EventLogReader reader(PATH);
+    ASSERT_EQ(reader.sessions().size(), 2u);
+    auto history = npcHistory(reader, 1);
+    EXPECT_FALSE(reader.truncated());
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history[0].tick, 3u);
+    reader.selectSession(0);
+    history = npcHistory(reader, 1);
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history[0].tick, 1u);
+}
+
+TEST_F(EventLogTest, RejectsForeignFile) {
+    std::ofstream(PATH) << "Dragon D killed Toad T at (1, 2)\n";
+    EXPECT_THROW(EventLogReader reader(PATH), std::runtime_error);
+    EXPECT_THROW(EventLogWriter writer(PATH), std::runtime_error);
+}
+
+TEST_F(EventLogTest, ObserverWritesWorldFights) {
+    World world;
+    World::Id dragon = world.add(NpcType::Dragon, "D", 3, 4);
+    World::Id knight = world.add(NpcType::Knight, "K", 5, 6);
+    {
+        auto observer = std::make_shared<BinaryLogObserver>(PATH);
+        WorldFightVisitor visitor(world, observer.get());
+        visitor.visit(dragon, knight, 42);
+        EXPECT_EQ(observer->writtenCount(), 0u);
+        observer->flush();
+        EXPECT_EQ(observer->writtenCount(), 1u);
+    }
+
+    EventLogReader reader(PATH);
+    auto history = npcHistory(reader, knight);
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history[0].tick, 42u);
+    EXPECT_EQ(history[0].attacker, dragon);
+    EXPECT_EQ(history[0].x, 5);
+    EXPECT_EQ(history[0].y, 6);
+    EXPECT_EQ(history[0].attacker_type, static_cast<std::uint8_t>(NpcType::Dragon));
+    EXPECT_EQ(history[0].success, 1);
+    EXPECT_EQ(history[0].killed, 0);  // visit только сверяет таблицу, бросок не делает
+}
+
+// убийства в журнале - это смерти в мире, а не победы по таблице видов
+TEST_F(EventLogTest, KillsMatchDeathsInWorld) {
+    World world = makeWorld(400, 7);
+    ThreadPool pool(2);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    std::size_t deaths = 0;
+    std::uint64_t table_wins = 0;
+    {
+        auto observer = std::make_shared<BinaryLogObserver>(PATH);
+        for (std::uint32_t tick = 1; tick <= 5; ++tick) {
+            simulation.move(tick);
+            std::vector<FightTask> fights;
+            simulation.detect(tick, fights);
+            deaths += resolveFights(world, fights, observer);
+            simulation.compact();
+        }
+    }
+    ASSERT_GT(deaths, 0u);
+
+    EventLogReader reader(PATH);
+    std::uint64_t logged = 0;
+    for (const auto& window : killsPerSpecies(reader, 0, UINT32_MAX, 0)) {
+        for (auto k : window.kills) logged += k;
+    }
+    reader.scan([](const EventBlockHeader&) { return true; },
+                [&](const EventBlockHeader&, const EventRecord* records, std::size_t count) {
+                    for (std::size_t i = 0; i < count; ++i) table_wins += records[i].success;
+                });
+    EXPECT_EQ(logged, deaths);
+    EXPECT_GT(table_wins, logged);
+}
@@ -7,6 +7,7 @@
 #include <cstdlib>
 
 #include "factory.h"
+#include "threadPool.h"
 #include "toad.h"
 #include "dragon.h"
 #include "knight.h"
@@ -229,4 +230,80 @@ TEST_F(FactoryTest, SaveMultipleNPCsToFileAndReload) {
         EXPECT_EQ(original_npcs[i]->getX(), loaded_npcs[i]->getX());
         EXPECT_EQ(original_npcs[i]->getY(), loaded_npcs[i]->getY());
     }
-}
\ No newline at end of file
+}
+
+TEST_F(FactoryTest, BulkSaveLoadRoundTrip) {
+    World world;
+    world.add(NpcType::Toad, "BulkToad", 0, 100);
+    world.add(NpcType::Dragon, "BulkDragon", 30, 40);
+    world.add(NpcType::Knight, "DeadKnight", 50, 60, false);
+
+    std::ostringstream out;
+    NPCFactory::save(world, out);
+    EXPECT_EQ(out.str(), "Toad BulkToad 0 100\nDragon BulkDragon 30 40\n");
+
+    World loaded;
+    ImportResult result = NPCFactory::load(out.str(), loaded);
+    EXPECT_EQ(result.loaded, 2u);
+    EXPECT_TRUE(result.errors.empty());
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded.getType(1), NpcType::Dragon);
+    EXPECT_EQ(loaded.getName(1), "BulkDragon");
+    EXPECT_EQ(loaded.getY(0), 100);
+    EXPECT_EQ(loaded.getKillDist(1), 30);
+}
+
+TEST_F(FactoryTest, BulkLoadReportsBadLines) {
+    std::string text =
+        "Toad T1 1 2\n"
+        "\n"
+        "Goblin G 1 2\n"
+        "Knight K1 5\n"
+        "Dragon D1 x 4\n"
+        "Dragon D2 1 200\n"
+        "Knight K2 5 6 extra\r\n"
+        "Knight K3 7 8\r\n";
+
+    World world;
+    ImportResult result = NPCFactory::load(text, world);
+    EXPECT_EQ(result.loaded, 2u);
+    ASSERT_EQ(result.errors.size(), 5u);
+    EXPECT_EQ(result.errors[0].line, 3u);
+    EXPECT_EQ(result.errors[0].message, "unknown NPC type");
+    EXPECT_EQ(result.errors[1].line, 4u);
+    EXPECT_EQ(result.errors[2].line, 5u);
+    EXPECT_EQ(result.errors[3].line, 6u);
+    EXPECT_EQ(result.errors[4].line, 7u);
+    EXPECT_EQ(world.getName(1), "K3");
+}
+
+TEST_F(FactoryTest, BulkLoadParallelMatchesSerial) {
+    // больше одного куска, чтобы сработало разбиение и сквозная нумерация строк
+    std::string text;
+    for (int i = 0; i < 200000; ++i) {
+        if (i % 50000 == 7) {
+            text += "Broken line\n";
+        } else {
+            text += "Knight Knight_" + std::to_string(i) + " " + std::to_string(i % 101) + " 3\n";
+        }
+    }
+
+    World serial;
+    World parallel;
+    ThreadPool pool(4);
+    ImportResult a = NPCFactory::load(text, serial);
+    ImportResult b = NPCFactory::load(text, parallel, &pool);
+
+    EXPECT_EQ(a.loaded, b.loaded);
+    ASSERT_EQ(a.errors.size(), 4u);
+    ASSERT_EQ(b.errors.size(), 4u);
+    for (std::size_t i = 0; i < a.errors.size(); ++i) {
+        EXPECT_EQ(a.errors[i].line, b.errors[i].line);
+        EXPECT_EQ(a.errors[i].line, i * 50000 + 8);
+    }
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (World::Id id = 0; id < serial.size(); id += 997) {
+        EXPECT_EQ(serial.getName(id), parallel.getName(id));
+        EXPECT_EQ(serial.getX(id), parallel.getX(id));
+    }
+}
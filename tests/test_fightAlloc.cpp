@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fightVisitor.h"
+#include "observer.h"
+#include "simulation.h"
+
+// счетчик всех operator new в бинарнике тестов
+namespace {
+std::atomic<std::uint64_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// наблюдатель на новом пути: копирует только числа
+class CountingObserver : public IFFightObserver {
+public:
+    int events = 0;
+    int wins = 0;
+    std::size_t name_bytes = 0;
+
+    void onFight(const std::shared_ptr<NPC>&, const std::shared_ptr<NPC>&, bool) override {}
+    void onFightEvent(const FightEvent& event) override {
+        ++events;
+        wins += event.success;
+        name_bytes += event.attacker.name.size() + event.defender.name.size();
+    }
+};
+
+// старый наблюдатель знает только onFight с shared_ptr
+class LegacyObserver : public IFFightObserver {
+public:
+    std::vector<std::string> seen;
+
+    void onFight(const std::shared_ptr<NPC>& attacker, const std::shared_ptr<NPC>& defender, bool success) override {
+        seen.push_back(attacker->getName() + (success ? ">" : "|") + defender->getName());
+    }
+};
+
+// вывод в никуда без буфера, который мог бы расти
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+World makeArena() {
+    World world;
+    for (int i = 0; i < 300; ++i) {
+        world.add(static_cast<NpcType>(i % 3), "Fighter_" + std::to_string(i), i % 50, i % 7);
+    }
+    return world;
+}
+
+std::vector<FightTask> allPairs(const World& world) {
+    std::vector<FightTask> tasks;
+    for (World::Id a = 0; a < world.size(); ++a) {
+        for (World::Id d = 0; d < world.size(); d += 13) {
+            if (a != d) tasks.push_back({a, d, a});
+        }
+    }
+    return tasks;
+}
+
+}
+
+TEST(FightAllocationTest, ResolveFightsDoesNotAllocate) {
+    World world = makeArena();
+    std::vector<FightTask> tasks = allPairs(world);
+    auto observer = std::make_shared<CountingObserver>();
+
+    std::uint64_t before = allocations.load();
+    std::size_t kills = resolveFights(world, tasks, observer);
+    std::uint64_t after = allocations.load();
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_GT(observer->events, 0);
+    EXPECT_GT(kills, 0u);
+    EXPECT_GT(observer->name_bytes, 0u);
+}
+
+TEST(FightAllocationTest, TextObserverPathDoesNotAllocate) {
+    World world = makeArena();
+    std::vector<FightTask> tasks = allPairs(world);
+    auto observer = std::make_shared<TextObserver>();
+
+    NullBuffer sink;
+    auto* old = std::cout.rdbuf(&sink);
+    std::uint64_t before = allocations.load();
+    std::size_t kills = resolveFights(world, tasks, observer);
+    std::uint64_t after = allocations.load();
+    std::cout.rdbuf(old);
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_GT(kills, 0u);
+}
+
+// текстовый журнал печатает только настоящие смерти, а не победы по таблице
+TEST(FightAllocationTest, TextObserverPrintsOnlyDeaths) {
+    World world = makeArena();
+    std::vector<FightTask> tasks = allPairs(world);
+    auto observer = std::make_shared<TextObserver>();
+
+    std::ostringstream out;
+    auto* old = std::cout.rdbuf(out.rdbuf());
+    std::size_t kills = resolveFights(world, tasks, observer);
+    std::cout.rdbuf(old);
+
+    std::string text = out.str();
+    EXPECT_GT(kills, 0u);
+    EXPECT_EQ(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')), kills);
+}
+
+TEST(FightAllocationTest, LegacyObserverStillNotified) {
+    World world;
+    World::Id toad = world.add(NpcType::Toad, "T", 1, 1);
+    World::Id dragon = world.add(NpcType::Dragon, "D", 2, 2);
+    auto observer = std::make_shared<LegacyObserver>();
+
+    WorldFightVisitor visitor(world, observer.get());
+    // наблюдатель старого пути получает исход боя (killed), а не таблицу
+    EXPECT_TRUE(visitor.visit(toad, dragon, 1, true));
+    EXPECT_TRUE(visitor.visit(toad, dragon, 2, false));
+    EXPECT_FALSE(visitor.visit(dragon, toad));
+    ASSERT_EQ(observer->seen.size(), 3u);
+    EXPECT_EQ(observer->seen[0], "T>D");
+    EXPECT_EQ(observer->seen[1], "T|D");
+    EXPECT_EQ(observer->seen[2], "D|T");
+}
+
+TEST(FightAllocationTest, EventTextMatchesSharedPtrText) {
+    World world;
+    World::Id knight = world.add(NpcType::Knight, "Sir", 5, 6);
+    World::Id dragon = world.add(NpcType::Dragon, "Smaug", 7, 8);
+
+    std::ostringstream via_event;
+    auto* old = std::cout.rdbuf(via_event.rdbuf());
+    TextObserver observer;
+    WorldFightVisitor(world, &observer).visit(knight, dragon, 1, true);
+    std::ostringstream via_shared;
+    std::cout.rdbuf(via_shared.rdbuf());
+    observer.onFight(world.npc(knight), world.npc(dragon), true);
+    std::cout.rdbuf(old);
+
+    EXPECT_EQ(via_event.str(), "Knight Sir killed Dragon Smaug at (7, 8)\n");
+    EXPECT_EQ(via_event.str(), via_shared.str());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fightResolver.h"
+#include "simulation.h"
+#include "testWorld.h"
+
+namespace {
+
+class RecordingObserver : public IFFightObserver {
+public:
+    std::vector<std::string> lines;
+
+    void onFight(const std::shared_ptr<NPC>&, const std::shared_ptr<NPC>&, bool) override {}
+    void onFightEvent(const FightEvent& event) override {
+        lines.push_back(std::string(event.attacker.name) + ">" + std::string(event.defender.name) +
+                        (event.success ? "+" : "-"));
+    }
+};
+
+}
+
+TEST(FightResolverTest, BatchesHaveNoSharedNpc) {
+    ThreadPool pool(2);
+    FightResolver resolver(pool);
+    World world = makeWorld(8, 1, 60);
+
+    resolver.resolve(world, {{0, 1, 1}, {2, 3, 1}, {4, 5, 1}}, nullptr);
+    EXPECT_EQ(resolver.batchCount(), 1u);
+
+    // все бои нпс 0 идут друг за другом, независимый бой попадает в первую пачку
+    resolver.resolve(world, {{0, 1, 2}, {2, 0, 2}, {0, 3, 2}, {6, 7, 2}}, nullptr);
+    EXPECT_EQ(resolver.batchCount(), 3u);
+
+    resolver.resolve(world, {}, nullptr);
+    EXPECT_EQ(resolver.batchCount(), 0u);
+}
+
+// несколько тиков на плотной карте: выжившие, убитые и события как при разборе по одному
+TEST(FightResolverTest, MatchesSerialResolution) {
+    for (std::size_t workers : {1u, 2u, 4u}) {
+        World serial_world = makeWorld(3000, 7, 60);
+        World parallel_world = makeWorld(3000, 7, 60);
+        ThreadPool serial_pool(1);
+        ThreadPool pool(workers);
+        Simulation serial(serial_world, serial_pool);
+        Simulation parallel(parallel_world, pool);
+        serial.indexWorld();
+        parallel.indexWorld();
+        FightResolver resolver(pool);
+        auto serial_log = std::make_shared<RecordingObserver>();
+        auto parallel_log = std::make_shared<RecordingObserver>();
+
+        std::size_t biggest = 0;
+        for (std::uint32_t tick = 1; tick <= 5; ++tick) {
+            std::vector<FightTask> serial_fights;
+            std::vector<FightTask> parallel_fights;
+            serial.move(tick);
+            parallel.move(tick);
+            serial.detect(tick, serial_fights);
+            parallel.detect(tick, parallel_fights);
+            biggest = std::max(biggest, parallel_fights.size());
+
+            EXPECT_EQ(resolveFights(serial_world, serial_fights, serial_log),
+                      resolver.resolve(parallel_world, parallel_fights, parallel_log));
+            serial.compact();
+            parallel.compact();
+        }
+
+        EXPECT_GT(biggest, FightResolver::MIN_PARALLEL_BATCH);
+        EXPECT_EQ(serial_world.getAlive(), parallel_world.getAlive());
+        EXPECT_EQ(serial_log->lines, parallel_log->lines);
+    }
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "grid.h"
+
+namespace {
+
+using PairSet = std::set<std::pair<SpatialGrid::Id, SpatialGrid::Id>>;
+
+std::pair<SpatialGrid::Id, SpatialGrid::Id> ordered(SpatialGrid::Id a, SpatialGrid::Id b) {
+    return {std::min(a, b), std::max(a, b)};
+}
+
+PairSet gridPairs(const SpatialGrid& grid) {
+    PairSet pairs;
+    grid.forEachCandidatePair([&](SpatialGrid::Id a, SpatialGrid::Id b) {
+        // каждая пара должна встречаться один раз
+        EXPECT_TRUE(pairs.insert(ordered(a, b)).second);
+    });
+    return pairs;
+}
+
+}
+
+TEST(SpatialGridTest, InsertAndRemove) {
+    SpatialGrid grid(30);
+    grid.insert(0, 10, 10);
+    grid.insert(1, 50, 50);
+    EXPECT_EQ(grid.size(), 2);
+    EXPECT_EQ(grid.cellCount(), 2);
+
+    grid.remove(0, 10, 10);
+    EXPECT_EQ(grid.size(), 1);
+    EXPECT_EQ(grid.cellCount(), 1);
+
+    // удаление отсутствующего не ломает сетку
+    grid.remove(0, 10, 10);
+    EXPECT_EQ(grid.size(), 1);
+}
+
+TEST(SpatialGridTest, InvalidCellSize) {
+    EXPECT_THROW(SpatialGrid(0), std::invalid_argument);
+}
+
+TEST(SpatialGridTest, FarApartNotCandidates) {
+    SpatialGrid grid(10);
+    grid.insert(0, 0, 0);
+    grid.insert(1, 25, 0);
+    EXPECT_TRUE(gridPairs(grid).empty());
+
+    grid.insert(2, 15, 5);
+    auto pairs = gridPairs(grid);
+    EXPECT_EQ(pairs.count({0, 2}), 1);
+    EXPECT_EQ(pairs.count({1, 2}), 1);
+    EXPECT_EQ(pairs.count({0, 1}), 0);
+}
+
+TEST(SpatialGridTest, MoveAcrossCellBorder) {
+    SpatialGrid grid(10);
+    grid.insert(0, 5, 5);
+    grid.insert(1, 45, 45);
+    EXPECT_TRUE(gridPairs(grid).empty());
+
+    grid.move(0, 5, 5, 38, 42);
+    EXPECT_EQ(grid.size(), 2);
+    EXPECT_EQ(gridPairs(grid).count({0, 1}), 1);
+}
+
+// переименование оставляет id на том же месте ячейки
+TEST(SpatialGridTest, RenameKeepsPlaceInCell) {
+    SpatialGrid grid(30);
+    grid.insert(0, 10, 10);
+    grid.insert(5, 12, 12);
+    grid.insert(1, 14, 14);
+    grid.rename(5, 2, 12, 12);
+    grid.rename(7, 3, 12, 12);  // нет в ячейке - ничего не меняется
+
+    std::vector<SpatialGrid::CellRef> cells;
+    grid.sortedCells(cells);
+    ASSERT_EQ(cells.size(), 1u);
+    EXPECT_EQ(*cells[0].ids, (std::vector<SpatialGrid::Id>{0, 2, 1}));
+    EXPECT_EQ(grid.size(), 3);
+}
+
+TEST(SpatialGridTest, NegativeCoordinates) {
+    SpatialGrid grid(10);
+    grid.insert(0, -5, -5);
+    grid.insert(1, 5, 5);
+    grid.insert(2, -25, 0);
+    auto pairs = gridPairs(grid);
+    EXPECT_EQ(pairs.count({0, 1}), 1);
+    EXPECT_EQ(pairs.count({0, 2}), 0);
+}
+
+// все пары в пределах размера ячейки должны найтись, как при полном переборе
+TEST(SpatialGridTest, MatchesBruteForce) {
+    const int cell = 30;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> coord(0, 300);
+
+    std::vector<std::pair<int, int>> points(500);
+    SpatialGrid grid(cell);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = {coord(gen), coord(gen)};
+        grid.insert(static_cast<SpatialGrid::Id>(i), points[i].first, points[i].second);
+    }
+
+    // случайные перемещения
+    for (size_t i = 0; i < points.size(); i += 3) {
+        auto [ox, oy] = points[i];
+        points[i] = {coord(gen), coord(gen)};
+        grid.move(static_cast<SpatialGrid::Id>(i), ox, oy, points[i].first, points[i].second);
+    }
+
+    PairSet candidates = gridPairs(grid);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = i + 1; j < points.size(); ++j) {
+            int dx = points[i].first - points[j].first;
+            int dy = points[i].second - points[j].second;
+            if (dx * dx + dy * dy <= cell * cell) {
+                EXPECT_EQ(candidates.count({static_cast<SpatialGrid::Id>(i), static_cast<SpatialGrid::Id>(j)}), 1);
+            }
+        }
+    }
+}
+
+TEST(SpatialGridTest, SparseChurnKeepsCellsConsistent) {
+    // большая разреженная карта: почти каждый нпс в своей ячейке, ячейки постоянно
+    // появляются и исчезают, таблица растет и удаляет со сдвигом
+    SpatialGrid grid(30);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(0, 1000000);
+    const SpatialGrid::Id n = 5000;
+
+    std::vector<std::pair<int, int>> pos(n);
+    for (SpatialGrid::Id id = 0; id < n; ++id) {
+        pos[id] = {coord(rng), coord(rng)};
+        grid.insert(id, pos[id].first, pos[id].second);
+    }
+    for (int round = 0; round < 5; ++round) {
+        for (SpatialGrid::Id id = 0; id < n; ++id) {
+            std::pair<int, int> next{coord(rng), coord(rng)};
+            grid.move(id, pos[id].first, pos[id].second, next.first, next.second);
+            pos[id] = next;
+        }
+    }
+    for (SpatialGrid::Id id = 0; id < n; id += 2) {
+        grid.remove(id, pos[id].first, pos[id].second);
+    }
+
+    std::vector<SpatialGrid::CellRef> cells;
+    grid.sortedCells(cells);
+    EXPECT_EQ(cells.size(), grid.cellCount());
+
+    std::set<SpatialGrid::Id> seen;
+    for (const auto& cell : cells) {
+        for (SpatialGrid::Id id : *cell.ids) {
+            EXPECT_EQ(id % 2, 1u);
+            EXPECT_TRUE(grid.sameCell(pos[id].first, pos[id].second, cell.cx * 30, cell.cy * 30));
+            seen.insert(id);
+        }
+    }
+    EXPECT_EQ(seen.size(), n / 2);
+    EXPECT_EQ(grid.size(), n / 2);
+}
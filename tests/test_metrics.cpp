@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "metrics.h"
+
+TEST(MetricsTest, CounterAndGauge) {
+    MetricsRegistry registry;
+    Counter& fights = registry.counter("fights_total", "Fights");
+    fights.add();
+    fights.add(4);
+    EXPECT_EQ(fights.value(), 5u);
+
+    Gauge& depth = registry.gauge("queue_depth", "Depth");
+    depth.set(10);
+    depth.add(-3);
+    EXPECT_EQ(depth.value(), 7);
+}
+
+TEST(MetricsTest, SameNameAndLabelGiveSameMetric) {
+    MetricsRegistry registry;
+    Counter& dragon = registry.counter("kills_total", "Kills", {"species", "Dragon"});
+    Counter& toad = registry.counter("kills_total", "Kills", {"species", "Toad"});
+    EXPECT_NE(&dragon, &toad);
+    EXPECT_EQ(&dragon, &registry.counter("kills_total", "Kills", {"species", "Dragon"}));
+    EXPECT_THROW(registry.gauge("kills_total", "Kills"), std::invalid_argument);
+}
+
+TEST(MetricsTest, HistogramBucketsKeepRelativeError) {
+    for (std::uint64_t v : {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123456789ull, 1ull << 40}) {
+        std::size_t bucket = Histogram::bucketOf(v);
+        ASSERT_LT(bucket, Histogram::BUCKETS);
+        std::uint64_t upper = Histogram::bucketUpper(bucket);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / Histogram::SUB_BUCKETS + 1) << v;
+    }
+    EXPECT_EQ(Histogram::bucketOf(UINT64_MAX), Histogram::BUCKETS - 1);
+    EXPECT_EQ(Histogram::bucketUpper(Histogram::BUCKETS - 1), UINT64_MAX);
+}
+
+TEST(MetricsTest, HistogramQuantiles) {
+    Histogram histogram;
+    EXPECT_EQ(histogram.quantile(0.5), 0u);
+    for (std::uint64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v * 1000);
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), 1000000u);
+    EXPECT_EQ(histogram.sum(), 500500000u);
+    EXPECT_NEAR(static_cast<double>(histogram.quantile(0.5)), 500000.0, 500000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(histogram.quantile(0.99)), 990000.0, 990000.0 / 32);
+    EXPECT_EQ(histogram.quantile(1.0), 1000000u);
+}
+
+TEST(MetricsTest, PrometheusText) {
+    MetricsRegistry registry;
+    registry.counter("kills_total", "Kills", {"species", "Dragon"}).add(3);
+    registry.gauge("alive", "Alive").set(42);
+    registry.counter("kills_total", "Kills", {"species", "Toad"}).add(1);
+    registry.histogram("phase_ns", "Phase", {"phase", "move"}).record(100);
+
+    std::ostringstream out;
+    registry.writePrometheus(out);
+    std::string text = out.str();
+    EXPECT_NE(text.find("# TYPE kills_total counter\nkills_total{species=\"Dragon\"} 3\nkills_total{species=\"Toad\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("alive 42\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE phase_ns summary\n"), std::string::npos);
+    EXPECT_NE(text.find("phase_ns{phase=\"move\",quantile=\"0.5\"} 100\n"), std::string::npos);
+    EXPECT_NE(text.find("phase_ns_count{phase=\"move\"} 1\n"), std::string::npos);
+}
+
+TEST(MetricsTest, JsonCountsRateSinceLastDump) {
+    MetricsRegistry registry;
+    Counter& fights = registry.counter("fights_total", "Fights");
+    fights.add(10);
+    std::ostringstream first;
+    registry.writeJson(first, 2.0);
+    EXPECT_NE(first.str().find("\"name\": \"fights_total\", \"type\": \"counter\", \"value\": 10, \"per_second\": 5}"),
+              std::string::npos);
+
+    fights.add(30);
+    std::ostringstream second;
+    registry.writeJson(second, 10.0);
+    EXPECT_NE(second.str().find("\"value\": 40, \"per_second\": 3}"), std::string::npos);
+}
+
+TEST(MetricsTest, DumperWritesFileOnExit) {
+    const std::string path = "test_metrics_dump.json";
+    std::remove(path.c_str());
+    MetricsRegistry registry;
+    registry.gauge("alive", "Alive").set(5);
+    {
+        MetricsDumper dumper(registry, path, std::chrono::milliseconds(1000), MetricsDumper::formatFor(path));
+    }
+    std::ifstream in(path);
+    ASSERT_TRUE(in);
+    std::stringstream content;
+    content << in.rdbuf();
+    EXPECT_NE(content.str().find("\"name\": \"alive\", \"type\": \"gauge\", \"value\": 5}"), std::string::npos);
+    EXPECT_EQ(MetricsDumper::formatFor("metrics.prom"), MetricsFormat::Prometheus);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "nameTable.h"
+
+TEST(NameTableTest, AddAndGet) {
+    NameTable table;
+    auto a = table.add("Toad_1");
+    auto b = table.add("");
+    auto c = table.add("Dragon_with_a_long_name_beyond_sso");
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(c, 2u);
+    EXPECT_EQ(table.get(a), "Toad_1");
+    EXPECT_EQ(table.get(b), "");
+    EXPECT_EQ(table.get(c), "Dragon_with_a_long_name_beyond_sso");
+    EXPECT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.bytes(), 6u + 34u);
+}
+
+TEST(NameTableTest, AddPackedKeepsIdsContiguous) {
+    NameTable table;
+    table.add("first");
+    const char packed[] = "xxAliceBobCarol";
+    const std::uint32_t offsets[] = {2, 7, 10, 15};
+    auto first = table.addPacked(3, packed, offsets);
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(table.get(1), "Alice");
+    EXPECT_EQ(table.get(2), "Bob");
+    EXPECT_EQ(table.get(3), "Carol");
+    EXPECT_EQ(table.get(0), "first");
+}
+
+TEST(NameTableTest, ManyNames) {
+    NameTable table;
+    for (int i = 0; i < 100000; ++i) {
+        table.add("Knight_" + std::to_string(i));
+    }
+    EXPECT_EQ(table.get(99999), "Knight_99999");
+    EXPECT_EQ(table.get(12345), "Knight_12345");
+}
+
+TEST(NameTableTest, CompactKeepsOnlyReferencedNames) {
+    NameTable table;
+    table.add("old_0");
+    table.add("Alice");
+    table.add("old_2");
+    table.add("Bob");
+    std::vector<NameTable::NameId> ids{3, 1};
+    table.compact(ids);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.bytes(), 8u);
+    EXPECT_EQ(ids[0], 0u);
+    EXPECT_EQ(ids[1], 1u);
+    EXPECT_EQ(table.get(ids[0]), "Bob");
+    EXPECT_EQ(table.get(ids[1]), "Alice");
+}
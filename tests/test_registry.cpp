@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "registry.h"
+#include "factory.h"
+
+// таблица и свойства видов считаются на этапе компиляции
+static_assert(canKill(NpcType::Toad, NpcType::Dragon));
+static_assert(!canKill(NpcType::Dragon, NpcType::Toad));
+static_assert(typeSymbol(NpcType::Knight) == 'K');
+static_assert(parseType("Dragon") == NpcType::Dragon);
+static_assert(MAX_KIND_KILL_DIST == 30);
+
+TEST(RegistryTest, OutcomeTable) {
+    //            | Toad | Dragon | Knight
+    // Toad       |  ✓   |   ✓    |   ✓
+    // Dragon     |  ✗   |   ✗    |   ✓
+    // Knight     |  ✗   |   ✓    |   ✗
+    const bool expected[3][3] = {
+        {true, true, true},
+        {false, false, true},
+        {false, true, false},
+    };
+    for (std::size_t a = 0; a < NPC_KIND_COUNT; ++a) {
+        for (std::size_t d = 0; d < NPC_KIND_COUNT; ++d) {
+            EXPECT_EQ(canKill(static_cast<NpcType>(a), static_cast<NpcType>(d)), expected[a][d])
+                << typeName(static_cast<NpcType>(a)) << " vs " << typeName(static_cast<NpcType>(d));
+        }
+    }
+}
+
+TEST(RegistryTest, KindInfoMatchesClasses) {
+    EXPECT_EQ(typeName(NpcType::Toad), "Toad");
+    EXPECT_EQ(typeSymbol(NpcType::Dragon), 'D');
+    EXPECT_EQ(kindInfo(NpcType::Knight).move_dist, 30);
+    EXPECT_EQ(kindInfo(NpcType::Dragon).kill_dist, 30);
+}
+
+TEST(RegistryTest, ParseType) {
+    EXPECT_EQ(parseType("Toad"), NpcType::Toad);
+    EXPECT_EQ(parseType("Knight"), NpcType::Knight);
+    EXPECT_FALSE(parseType("Orc").has_value());
+    EXPECT_FALSE(parseType("").has_value());
+}
+
+TEST(RegistryTest, MakeNpcUsesRegisteredClass) {
+    for (std::size_t i = 0; i < NPC_KIND_COUNT; ++i) {
+        auto type = static_cast<NpcType>(i);
+        auto npc = makeNpc(type, "Made", 1, 2);
+        ASSERT_NE(npc, nullptr);
+        EXPECT_EQ(npc->getTypeTag(), type);
+        EXPECT_EQ(npc->getType(), typeName(type));
+        EXPECT_EQ(npc->getKillDist(), kindInfo(type).kill_dist);
+    }
+    EXPECT_EQ(makeNpc(static_cast<NpcType>(999), "Bad", 0, 0), nullptr);
+}
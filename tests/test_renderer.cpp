@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "renderer.h"
+
+TEST(RendererTest, PlainFrameIsFullMap) {
+    TerminalRenderer renderer(3, 2, false);
+    renderer.beginFrame();
+    renderer.plot(1, 0, 'D');
+    renderer.plot(2, 1, 'K');
+    std::string frame(renderer.finishFrame("status"));
+    EXPECT_EQ(frame, "status\n\n.D.\n..K\n\n------------------------------\n");
+    EXPECT_EQ(frame.find('\x1b'), std::string::npos);
+}
+
+TEST(RendererTest, FirstAnsiFrameDrawsEverything) {
+    TerminalRenderer renderer(4, 2, true, 40);
+    renderer.beginFrame();
+    renderer.plot(0, 0, 'T');
+    std::string frame(renderer.finishFrame("line one\nline two"));
+    EXPECT_NE(frame.find("\x1b[2J"), std::string::npos);
+    EXPECT_NE(frame.find("line one"), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[6;1HT..."), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[7;1H...."), std::string::npos);
+    EXPECT_EQ(renderer.changedCells(), 8u);
+}
+
+TEST(RendererTest, UnchangedFrameWritesNoCells) {
+    TerminalRenderer renderer(4, 2, true, 40);
+    renderer.beginFrame();
+    renderer.plot(0, 0, 'T');
+    renderer.finishFrame("status");
+    renderer.beginFrame();
+    renderer.plot(0, 0, 'T');
+    std::string frame(renderer.finishFrame("status"));
+    EXPECT_EQ(renderer.changedCells(), 0u);
+    EXPECT_EQ(frame.find("\x1b[2J"), std::string::npos);
+    EXPECT_EQ(frame.find("\x1b[6;"), std::string::npos);
+    EXPECT_EQ(frame.find("\x1b[7;"), std::string::npos);
+}
+
+TEST(RendererTest, OnlyChangedCellsAreWritten) {
+    TerminalRenderer renderer(5, 2, true, 40);
+    renderer.beginFrame();
+    renderer.plot(0, 0, 'T');
+    renderer.finishFrame("status");
+    renderer.beginFrame();
+    renderer.plot(2, 1, 'D');
+    renderer.plot(3, 1, 'K');
+    std::string frame(renderer.finishFrame("status"));
+    EXPECT_EQ(renderer.changedCells(), 3u);
+    EXPECT_NE(frame.find("\x1b[6;1H."), std::string::npos);
+    // соседние изменения идут одной вставкой
+    EXPECT_NE(frame.find("\x1b[7;3HDK"), std::string::npos);
+}
+
+TEST(RendererTest, InvalidateForcesFullRedraw) {
+    TerminalRenderer renderer(2, 2, true, 40);
+    renderer.beginFrame();
+    renderer.finishFrame("status");
+    renderer.invalidate();
+    renderer.beginFrame();
+    std::string frame(renderer.finishFrame("status"));
+    EXPECT_NE(frame.find("\x1b[2J"), std::string::npos);
+    EXPECT_EQ(renderer.changedCells(), 4u);
+}
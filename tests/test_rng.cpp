@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rng.h"
+
+// контрольные значения Philox4x32-10 из набора Random123
+TEST(RngTest, PhiloxKnownAnswers) {
+    using Block = std::array<std::uint32_t, 4>;
+    EXPECT_EQ(philox4x32({0, 0, 0, 0}, {0, 0}), (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(RngTest, SameInputsSameSequence) {
+    CounterRng a(42, RngStream::Move, 7, 100);
+    CounterRng b(42, RngStream::Move, 7, 100);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(a.next(), b.next());
+    }
+}
+
+TEST(RngTest, StreamsTicksAndEntitiesDiffer) {
+    std::set<std::uint32_t> firsts;
+    firsts.insert(CounterRng(42, RngStream::Move, 7, 100).next());
+    firsts.insert(CounterRng(42, RngStream::Dice, 7, 100).next());
+    firsts.insert(CounterRng(42, RngStream::Move, 8, 100).next());
+    firsts.insert(CounterRng(42, RngStream::Move, 7, 101).next());
+    firsts.insert(CounterRng(43, RngStream::Move, 7, 100).next());
+    firsts.insert(CounterRng(42, RngStream::Move, 7, 100, 1).next());
+    EXPECT_EQ(firsts.size(), 6);
+}
+
+TEST(RngTest, BelowStaysInRangeAndCoversIt) {
+    CounterRng rng(1, RngStream::Dice, 0, 0);
+    std::array<int, 6> counts{};
+    for (int i = 0; i < 6000; ++i) {
+        int v = rng.below(6);
+        ASSERT_GE(v, 0);
+        ASSERT_LT(v, 6);
+        counts[v]++;
+    }
+    for (int c : counts) {
+        EXPECT_GT(c, 800);
+        EXPECT_LT(c, 1200);
+    }
+}
+
+// результат не зависит от того, в каком потоке считается
+TEST(RngTest, IndependentOfThreads) {
+    const int n = 64;
+    std::vector<std::uint32_t> serial(n), parallel(n);
+    for (int i = 0; i < n; ++i) {
+        serial[i] = CounterRng(9, RngStream::Move, 3, i).next();
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = t; i < n; i += 4) {
+                parallel[i] = CounterRng(9, RngStream::Move, 3, i).next();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(serial, parallel);
+}
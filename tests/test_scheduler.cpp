@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "scheduler.h"
+#include "testWorld.h"
+
+namespace {
+
+struct RunResult {
+    RunStats stats;
+    std::vector<std::uint8_t> alive;
+    std::vector<int> xs;
+};
+
+RunResult runHeadless(std::size_t workers, std::uint32_t ticks) {
+    World world = makeWorld(200, 5);
+    ThreadPool pool(workers);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    TickScheduler scheduler(simulation, [&](std::uint32_t, const std::vector<FightTask>& fights) {
+        return resolveFights(world, fights, nullptr);
+    });
+    RunResult result{scheduler.runHeadless(ticks), world.getAlive(), world.getXs()};
+    EXPECT_EQ(scheduler.lastTick(), ticks);
+    return result;
+}
+
+}
+
+TEST(SchedulerTest, HeadlessCountsTicksAndUpdates) {
+    auto result = runHeadless(1, 20);
+    EXPECT_EQ(result.stats.ticks, 20u);
+    EXPECT_GT(result.stats.npc_updates, 0u);
+    EXPECT_LE(result.stats.npc_updates, 20u * 200u);
+    EXPECT_GT(result.stats.fights, 0u);
+    EXPECT_GT(result.stats.kills, 0u);
+    EXPECT_GE(result.stats.ticksPerSecond(), 0.0);
+}
+
+// одно зерно - один и тот же исход при любом числе потоков
+TEST(SchedulerTest, HeadlessIsDeterministic) {
+    setRunSeed(77);
+    auto serial = runHeadless(1, 30);
+    auto parallel = runHeadless(4, 30);
+
+    EXPECT_EQ(serial.stats.kills, parallel.stats.kills);
+    EXPECT_EQ(serial.stats.fights, parallel.stats.fights);
+    EXPECT_EQ(serial.alive, parallel.alive);
+    EXPECT_EQ(serial.xs, parallel.xs);
+    setRunSeed(0);
+}
+
+TEST(SchedulerTest, FixedStepPacesTicks) {
+    World world = makeWorld(20, 5);
+    ThreadPool pool(1);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    std::vector<std::uint32_t> seen_ticks;
+    TickScheduler scheduler(simulation, [&](std::uint32_t tick, const std::vector<FightTask>&) {
+        seen_ticks.push_back(tick);
+        return std::size_t{0};
+    });
+
+    std::atomic<bool> running{true};
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        running = false;
+    });
+    RunStats stats = scheduler.runFixed(std::chrono::milliseconds(20), running);
+    stopper.join();
+
+    // ~5 тиков за 100 мс, с запасом на планировщик ОС
+    EXPECT_GE(stats.ticks, 2u);
+    EXPECT_LE(stats.ticks, 10u);
+    ASSERT_EQ(seen_ticks.size(), stats.ticks);
+    for (std::size_t i = 0; i < seen_ticks.size(); ++i) {
+        EXPECT_EQ(seen_ticks[i], i + 1);
+    }
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "simulation.h"
+#include "testWorld.h"
+
+namespace {
+
+bool sameTasks(const std::vector<FightTask>& a, const std::vector<FightTask>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].attacker != b[i].attacker || a[i].defender != b[i].defender || a[i].tick != b[i].tick) return false;
+    }
+    return true;
+}
+
+}
+
+// параллельный поиск по тайлам совпадает с последовательным обходом
+TEST(SimulationTest, ParallelDetectMatchesSerial) {
+    World world = makeWorld(400, 1);
+    ThreadPool pool(4);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    std::vector<FightTask> parallel;
+    simulation.detect(1, parallel);
+
+    std::vector<FightTask> serial;
+    detectFights(world, simulation.getGrid(), 1, serial);
+
+    EXPECT_FALSE(serial.empty());
+    EXPECT_TRUE(sameTasks(parallel, serial));
+}
+
+// с пределом detect отдает начало полного списка и сообщает, что уперся
+TEST(SimulationTest, FightLimitKeepsPrefix) {
+    World world = makeWorld(400, 1);
+    ThreadPool pool(4);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    std::vector<FightTask> full;
+    simulation.detect(1, full);
+    EXPECT_FALSE(simulation.lastDetectCapped());
+    ASSERT_GT(full.size(), 3u);
+
+    std::size_t limit = full.size() / 2;
+    simulation.setFightLimit(limit);
+    std::vector<FightTask> capped;
+    simulation.detect(1, capped);
+    EXPECT_TRUE(simulation.lastDetectCapped());
+    EXPECT_TRUE(sameTasks(capped, std::vector<FightTask>(full.begin(), full.begin() + static_cast<std::ptrdiff_t>(limit))));
+}
+
+// несколько тиков движения и поиска дают одно и то же при любом числе потоков
+TEST(SimulationTest, IndependentOfWorkerCount) {
+    std::vector<std::vector<FightTask>> runs;
+    std::vector<std::vector<int>> positions;
+
+    for (std::size_t workers : {1u, 3u, 4u}) {
+        World world = makeWorld(300, 2);
+        ThreadPool pool(workers);
+        Simulation simulation(world, pool);
+        simulation.indexWorld();
+
+        std::vector<FightTask> fights;
+        for (std::uint32_t tick = 1; tick <= 5; ++tick) {
+            simulation.move(tick);
+            simulation.detect(tick, fights);
+            world.kill(tick);  // выбывшие должны уйти из сетки
+            simulation.compact();
+        }
+        runs.push_back(fights);
+        positions.push_back(world.getXs());
+        EXPECT_EQ(simulation.getGrid().size(), world.aliveCount());
+    }
+
+    EXPECT_TRUE(sameTasks(runs[0], runs[1]));
+    EXPECT_TRUE(sameTasks(runs[0], runs[2]));
+    EXPECT_EQ(positions[0], positions[1]);
+    EXPECT_EQ(positions[0], positions[2]);
+}
+
+TEST(SimulationTest, MoveKeepsGridInSync) {
+    World world = makeWorld(200, 3);
+    ThreadPool pool(2);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    for (std::uint32_t tick = 1; tick <= 10; ++tick) {
+        simulation.move(tick);
+    }
+
+    // после перемещений сетка дает те же пары, что и свежая раскладка
+    std::vector<FightTask> incremental;
+    simulation.detect(11, incremental);
+
+    simulation.indexWorld();
+    std::vector<FightTask> rebuilt;
+    simulation.detect(11, rebuilt);
+
+    EXPECT_EQ(incremental.size(), rebuilt.size());
+}
+
+// после уборки мертвых нет: новые нпс встают в конец плотного мира
+TEST(SimulationTest, SpawnAfterCompactAppends) {
+    World world = makeWorld(50, 4);
+    ThreadPool pool(2);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    world.kill(3);
+    world.kill(7);
+    simulation.move(1);
+    EXPECT_EQ(simulation.compact(), 2u);
+    EXPECT_EQ(world.size(), 48u);
+    EXPECT_EQ(world.freeSlots(), 0u);
+    EXPECT_EQ(simulation.getGrid().size(), 48u);
+
+    World::Id a = simulation.spawn(NpcType::Knight, "Fresh", 50, 50);
+    EXPECT_EQ(a, 48u);
+    EXPECT_EQ(world.getUid(a), 50u);
+    EXPECT_TRUE(world.isAlive(a));
+    EXPECT_EQ(world.getName(a), "Fresh");
+    EXPECT_EQ(world.getKillDist(a), 10);
+    EXPECT_EQ(simulation.getGrid().size(), 49u);
+}
+
+// мертвые в середине тоже уходят: дыры занимают нпс с конца, сетка видит их под новыми id
+TEST(SimulationTest, CompactFillsHoles) {
+    World world = makeWorld(50, 5);
+    ThreadPool pool(2);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    world.kill(10);
+    world.kill(48);
+    world.kill(49);
+    EXPECT_EQ(simulation.compact(), 3u);
+    EXPECT_EQ(world.size(), 47u);
+    EXPECT_EQ(world.aliveCount(), 47u);
+    EXPECT_EQ(world.getUid(10), 47u);
+    EXPECT_EQ(simulation.getGrid().size(), 47u);
+    EXPECT_EQ(simulation.compact(), 0u);
+
+    // пары те же, что после полной раскладки; порядок в ячейке у переехавшего прежний
+    auto byUid = [&world](const std::vector<FightTask>& tasks) {
+        std::set<std::pair<World::Uid, World::Uid>> pairs;
+        for (const auto& task : tasks) pairs.insert({world.getUid(task.attacker), world.getUid(task.defender)});
+        return pairs;
+    };
+    std::vector<FightTask> compacted;
+    simulation.detect(1, compacted);
+    simulation.indexWorld();
+    std::vector<FightTask> rebuilt;
+    simulation.detect(1, rebuilt);
+    EXPECT_FALSE(compacted.empty());
+    EXPECT_EQ(byUid(compacted), byUid(rebuilt));
+}
+
+// в очередь боев не попадают повторы и мертвые: каждая пара за тик ровно один раз,
+// убитые прошлого тика убраны compact до поиска
+TEST(SimulationTest, DetectGivesEachLivingPairOncePerTick) {
+    World world = makeWorld(600, 6);
+    ThreadPool pool(3);
+    Simulation simulation(world, pool);
+    simulation.indexWorld();
+
+    for (std::uint32_t tick = 1; tick <= 5; ++tick) {
+        simulation.move(tick);
+        std::vector<FightTask> fights;
+        simulation.detect(tick, fights);
+        ASSERT_FALSE(fights.empty());
+
+        std::set<std::pair<World::Id, World::Id>> pairs;
+        for (const auto& task : fights) {
+            EXPECT_TRUE(world.isAlive(task.attacker));
+            EXPECT_TRUE(world.isAlive(task.defender));
+            EXPECT_TRUE(pairs.insert({std::min(task.attacker, task.defender),
+                                      std::max(task.attacker, task.defender)}).second);
+        }
+        resolveFights(world, fights, nullptr);
+        simulation.compact();
+    }
+}
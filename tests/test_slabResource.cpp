@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "slabResource.h"
+
+TEST(SlabResourceTest, ReusesFreedBlocks) {
+    SlabResource slab;
+    void* a = slab.allocate(72, alignof(std::max_align_t));
+    slab.deallocate(a, 72, alignof(std::max_align_t));
+    void* b = slab.allocate(80, alignof(std::max_align_t));
+    EXPECT_EQ(a, b);  // тот же класс размера
+    slab.deallocate(b, 80, alignof(std::max_align_t));
+    EXPECT_EQ(slab.slabCount(), 1u);
+}
+
+TEST(SlabResourceTest, BlocksDoNotOverlap) {
+    SlabResource slab;
+    std::vector<char*> blocks;
+    for (int i = 0; i < 5000; ++i) {
+        auto* p = static_cast<char*>(slab.allocate(48, 16));
+        std::fill(p, p + 48, static_cast<char>(i));
+        blocks.push_back(p);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(blocks[i][0], static_cast<char>(i));
+        EXPECT_EQ(blocks[i][47], static_cast<char>(i));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blocks[i]) % 16, 0u);
+    }
+    EXPECT_GT(slab.slabCount(), 1u);
+    for (char* p : blocks) slab.deallocate(p, 48, 16);
+}
+
+TEST(SlabResourceTest, LargeRequestsGoUpstream) {
+    SlabResource slab;
+    void* big = slab.allocate(SlabResource::MAX_BLOCK + 1, 16);
+    EXPECT_EQ(slab.slabCount(), 0u);
+    slab.deallocate(big, SlabResource::MAX_BLOCK + 1, 16);
+}
+
+TEST(SlabResourceTest, WorksWithAllocateShared) {
+    SlabResource slab;
+    std::pmr::polymorphic_allocator<int> alloc(&slab);
+    std::weak_ptr<int> weak;
+    {
+        auto p = std::allocate_shared<int>(alloc, 42);
+        weak = p;
+        EXPECT_EQ(*p, 42);
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(SlabResourceTest, ConcurrentAllocFree) {
+    SlabResource slab;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&slab] {
+            for (int i = 0; i < 20000; ++i) {
+                void* p = slab.allocate(64, 16);
+                *static_cast<int*>(p) = i;
+                EXPECT_EQ(*static_cast<int*>(p), i);
+                slab.deallocate(p, 64, 16);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+}
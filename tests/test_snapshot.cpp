@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "snapshot.h"
+#include "toad.h"
+#include "dragon.h"
+#include "knight.h"
+
+namespace {
+
+const char* SNAPSHOT = "test_snapshot.bin";
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        world.add(Toad("SnapToad", 10, 20));
+        world.add(Dragon("SnapDragon", 0, 100));
+        world.add(Knight("", 50, 60));
+        world.kill(1);
+    }
+
+    void TearDown() override { std::remove(SNAPSHOT); }
+
+    // испортить байты снимка по смещению
+    void patch(std::size_t offset, const void* bytes, std::size_t size) {
+        std::fstream f(SNAPSHOT, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(static_cast<std::streamoff>(offset));
+        f.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    }
+
+    SnapshotHeader readHeader() {
+        SnapshotHeader header{};
+        std::ifstream f(SNAPSHOT, std::ios::binary);
+        f.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return header;
+    }
+
+    World world;
+};
+
+}
+
+TEST_F(SnapshotTest, RoundTripKeepsAllColumns) {
+    saveSnapshot(world, SNAPSHOT);
+
+    World loaded;
+    loadSnapshot(SNAPSHOT, loaded);
+
+    ASSERT_EQ(loaded.size(), world.size());
+    for (World::Id id = 0; id < world.size(); ++id) {
+        EXPECT_EQ(loaded.getType(id), world.getType(id));
+        EXPECT_EQ(loaded.getName(id), world.getName(id));
+        EXPECT_EQ(loaded.getX(id), world.getX(id));
+        EXPECT_EQ(loaded.getY(id), world.getY(id));
+        EXPECT_EQ(loaded.isAlive(id), world.isAlive(id));
+        EXPECT_EQ(loaded.getMoveDist(id), world.getMoveDist(id));
+        EXPECT_EQ(loaded.getKillDist(id), world.getKillDist(id));
+    }
+}
+
+TEST_F(SnapshotTest, ViewReadsInPlace) {
+    saveSnapshot(world, SNAPSHOT);
+    SnapshotView view(SNAPSHOT);
+
+    EXPECT_EQ(view.version(), SNAPSHOT_VERSION);
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.getType(0), NpcType::Toad);
+    EXPECT_EQ(view.getName(1), "SnapDragon");
+    EXPECT_EQ(view.getName(2), "");
+    EXPECT_EQ(view.ys()[1], 100);
+    EXPECT_EQ(view.alive()[1], 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.xs()) % 64, 0u);
+}
+
+TEST_F(SnapshotTest, EmptyWorld) {
+    World empty;
+    saveSnapshot(empty, SNAPSHOT);
+    World loaded;
+    loadSnapshot(SNAPSHOT, loaded);
+    EXPECT_EQ(loaded.size(), 0u);
+}
+
+TEST_F(SnapshotTest, AppendsToExistingWorld) {
+    saveSnapshot(world, SNAPSHOT);
+    loadSnapshot(SNAPSHOT, world);
+    ASSERT_EQ(world.size(), 6u);
+    EXPECT_EQ(world.getName(3), "SnapToad");
+}
+
+TEST_F(SnapshotTest, MissingFileThrows) {
+    World loaded;
+    EXPECT_THROW(loadSnapshot("no_such_snapshot.bin", loaded), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, BadMagicThrows) {
+    saveSnapshot(world, SNAPSHOT);
+    patch(0, "XXXX", 4);
+    EXPECT_THROW(SnapshotView view(SNAPSHOT), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, UnsupportedVersionThrows) {
+    saveSnapshot(world, SNAPSHOT);
+    std::uint32_t version = SNAPSHOT_VERSION + 1;
+    patch(offsetof(SnapshotHeader, version), &version, sizeof(version));
+    EXPECT_THROW(SnapshotView view(SNAPSHOT), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, OversizedCountThrows) {
+    saveSnapshot(world, SNAPSHOT);
+    std::uint64_t count = 1u << 30;
+    patch(offsetof(SnapshotHeader, count), &count, sizeof(count));
+    EXPECT_THROW(SnapshotView view(SNAPSHOT), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, UnknownTypeThrows) {
+    saveSnapshot(world, SNAPSHOT);
+    std::uint8_t bad = 7;
+    patch(readHeader().types_offset, &bad, 1);
+    EXPECT_THROW(SnapshotView view(SNAPSHOT), std::runtime_error);
+}
+
+TEST_F(SnapshotTest, CoordinatesOutOfMapThrowOnLoad) {
+    saveSnapshot(world, SNAPSHOT);
+    std::int32_t x = 500;
+    patch(readHeader().xs_offset, &x, sizeof(x));
+    World loaded;
+    EXPECT_THROW(loadSnapshot(SNAPSHOT, loaded), std::runtime_error);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "threadPool.h"
+
+TEST(ThreadPoolTest, RunsEveryIndexOnce) {
+    for (std::size_t workers : {1u, 2u, 4u}) {
+        ThreadPool pool(workers);
+        EXPECT_EQ(pool.size(), workers);
+
+        std::vector<std::atomic<int>> hits(1000);
+        pool.parallelFor(hits.size(), [&](std::size_t i) { hits[i]++; });
+        for (auto& h : hits) {
+            EXPECT_EQ(h.load(), 1);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, ReusableAcrossCalls) {
+    ThreadPool pool(3);
+    std::atomic<long> sum{0};
+    for (int round = 0; round < 50; ++round) {
+        pool.parallelFor(100, [&](std::size_t i) { sum += static_cast<long>(i); });
+    }
+    EXPECT_EQ(sum.load(), 50L * 4950L);
+}
+
+TEST(ThreadPoolTest, EmptyRangeAndDefaultSize) {
+    ThreadPool pool;
+    EXPECT_GE(pool.size(), 1u);
+    bool called = false;
+    pool.parallelFor(0, [&](std::size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+// неравномерные задачи: свободные потоки должны забрать чужую работу
+TEST(ThreadPoolTest, UnevenTasksComplete) {
+    ThreadPool pool(4);
+    std::atomic<int> done{0};
+    pool.parallelFor(64, [&](std::size_t i) {
+        std::atomic<long> spin{0};
+        for (long k = 0; k < (i < 16 ? 20000 : 10); ++k) spin.fetch_add(k, std::memory_order_relaxed);
+        done++;
+    });
+    EXPECT_EQ(done.load(), 64);
+}
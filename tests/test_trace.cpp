@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "trace.h"
+
+#ifdef LAB7_TRACING
+
+TEST(TraceTest, SpansFromThreadsGoToTheirBuffers) {
+    startTracing();
+    traceThreadName("test main");
+    {
+        TRACE_SCOPE("outer", "test");
+        std::thread worker([] {
+            traceThreadName("test worker");
+            TRACE_SCOPE("inner", "test");
+        });
+        worker.join();
+    }
+    stopTracing();
+    {
+        TRACE_SCOPE("after stop", "test");
+    }
+
+    EXPECT_EQ(traceSpanCount(), 2u);
+    std::ostringstream out;
+    writeTrace(out);
+    std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [", 0), 0u);
+    EXPECT_NE(json.find("\"name\": \"outer\", \"cat\": \"test\", \"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"inner\""), std::string::npos);
+    EXPECT_EQ(json.find("after stop"), std::string::npos);
+    EXPECT_NE(json.find("\"args\": {\"name\": \"test worker\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\": {\"name\": \"test main\"}"), std::string::npos);
+}
+
+TEST(TraceTest, StartForgetsOldSpans) {
+    startTracing();
+    {
+        TRACE_SCOPE("old", "test");
+    }
+    startTracing();
+    {
+        TRACE_SCOPE("new", "test");
+    }
+    stopTracing();
+    std::ostringstream out;
+    writeTrace(out);
+    EXPECT_EQ(out.str().find("\"old\""), std::string::npos);
+    EXPECT_NE(out.str().find("\"new\""), std::string::npos);
+}
+
+#else
+
+// без LAB7_TRACING спаны не записываются даже при включенной трассировке
+TEST(TraceTest, CompiledOutRecordsNothing) {
+    startTracing();
+    {
+        TRACE_SCOPE("ignored", "test");
+    }
+    stopTracing();
+    EXPECT_EQ(traceSpanCount(), 0u);
+}
+
+#endif
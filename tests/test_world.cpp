@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "world.h"
+#include "worldConfig.h"
+#include "toad.h"
+#include "dragon.h"
+#include "knight.h"
+
+class WorldTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        toad_id = world.add(Toad("WorldToad", 10, 20));
+        dragon_id = world.add(Dragon("WorldDragon", 13, 24));
+        knight_id = world.add(Knight("WorldKnight", 50, 60));
+    }
+
+    World world;
+    World::Id toad_id;
+    World::Id dragon_id;
+    World::Id knight_id;
+};
+
+TEST_F(WorldTest, AddKeepsFields) {
+    EXPECT_EQ(world.size(), 3);
+    EXPECT_EQ(toad_id, 0);
+    EXPECT_EQ(knight_id, 2);
+
+    EXPECT_EQ(world.getX(dragon_id), 13);
+    EXPECT_EQ(world.getY(dragon_id), 24);
+    EXPECT_EQ(world.getType(dragon_id), NpcType::Dragon);
+    EXPECT_EQ(world.getName(dragon_id), "WorldDragon");
+    EXPECT_EQ(world.getMoveDist(dragon_id), 50);
+    EXPECT_EQ(world.getKillDist(dragon_id), 30);
+    EXPECT_TRUE(world.isAlive(dragon_id));
+}
+
+TEST_F(WorldTest, ArraysAreParallel) {
+    EXPECT_EQ(world.getXs().size(), 3);
+    EXPECT_EQ(world.getXs()[knight_id], 50);
+    EXPECT_EQ(world.getYs()[knight_id], 60);
+    EXPECT_EQ(world.getTypes()[toad_id], static_cast<std::uint8_t>(NpcType::Toad));
+    EXPECT_EQ(world.getKillDists()[toad_id], 10);
+}
+
+TEST_F(WorldTest, KillAndAliveCount) {
+    EXPECT_EQ(world.aliveCount(), 3);
+    world.kill(toad_id);
+    EXPECT_FALSE(world.isAlive(toad_id));
+    EXPECT_EQ(world.aliveCount(), 2);
+}
+
+TEST_F(WorldTest, DistanceAndMaxKillDist) {
+    EXPECT_DOUBLE_EQ(world.distance(toad_id, dragon_id), 5.0);
+    EXPECT_EQ(world.maxKillDist(), 30);
+}
+
+// на карте предельного размера квадрат расстояния не влезает в int
+TEST_F(WorldTest, DistanceOnHugeMap) {
+    World::Id near = world.add(NpcType::Toad, "Near", 0, 0);
+    World::Id far = world.add(NpcType::Toad, "Far", WorldConfig::MAX_SIDE, WorldConfig::MAX_SIDE);
+    EXPECT_DOUBLE_EQ(world.distance(near, far), WorldConfig::MAX_SIDE * std::sqrt(2.0));
+}
+
+TEST_F(WorldTest, MoveRandomStepsByMoveDist) {
+    int x = world.getX(toad_id);
+    int y = world.getY(toad_id);
+    world.moveRandom(toad_id, 0);
+    EXPECT_LE(std::abs(world.getX(toad_id) - x), 1);
+    EXPECT_LE(std::abs(world.getY(toad_id) - y), 1);
+
+    // мертвые не двигаются
+    world.kill(knight_id);
+    world.moveRandom(knight_id, 0);
+    EXPECT_EQ(world.getX(knight_id), 50);
+    EXPECT_EQ(world.getY(knight_id), 60);
+}
+
+TEST_F(WorldTest, FacadeMatchesStore) {
+    world.kill(knight_id);
+    auto npc = world.npc(knight_id);
+    ASSERT_NE(npc, nullptr);
+    EXPECT_EQ(npc->getType(), "Knight");
+    EXPECT_EQ(npc->getName(), "WorldKnight");
+    EXPECT_EQ(npc->getX(), 50);
+    EXPECT_EQ(npc->getY(), 60);
+    EXPECT_FALSE(npc->isAlive());
+}
+
+TEST_F(WorldTest, AddByTypeTakesDistancesFromRegistry) {
+    World::Id id = world.add(NpcType::Knight, "Plain", 5, 6, false);
+    EXPECT_EQ(world.getName(id), "Plain");
+    EXPECT_EQ(world.getMoveDist(id), 30);
+    EXPECT_EQ(world.getKillDist(id), 10);
+    EXPECT_FALSE(world.isAlive(id));
+    EXPECT_THROW(world.add(static_cast<NpcType>(9), "Bad", 0, 0), std::invalid_argument);
+}
+
+TEST_F(WorldTest, ReleaseOnlyFreesDead) {
+    world.release(toad_id);
+    EXPECT_EQ(world.freeSlots(), 0u);
+
+    world.kill(toad_id);
+    world.release(toad_id);
+    EXPECT_EQ(world.freeSlots(), 1u);
+
+    World::Id id = world.spawn(NpcType::Dragon, "Reborn", 1, 1);
+    EXPECT_EQ(id, toad_id);
+    EXPECT_EQ(world.size(), 3u);
+    EXPECT_EQ(world.getType(id), NpcType::Dragon);
+    EXPECT_EQ(world.getMoveDist(id), 50);
+    EXPECT_TRUE(world.isAlive(id));
+
+    // свободных нет - в конец
+    EXPECT_EQ(world.spawn(NpcType::Toad, "Tail", 2, 2), 3u);
+}
+
+// повторное освобождение не отдает слот двум нпс
+TEST_F(WorldTest, ReleaseTwiceFreesOnce) {
+    world.kill(toad_id);
+    world.release(toad_id);
+    world.release(toad_id);
+    world.release(100);
+    EXPECT_EQ(world.freeSlots(), 1u);
+
+    World::Id first = world.spawn(NpcType::Dragon, "First", 1, 1);
+    World::Id second = world.spawn(NpcType::Knight, "Second", 2, 2);
+    EXPECT_EQ(first, toad_id);
+    EXPECT_EQ(second, 3u);
+    EXPECT_EQ(world.getName(first), "First");
+    EXPECT_EQ(world.getName(second), "Second");
+
+    // слот снова занят: его можно убить и освободить заново
+    world.kill(first);
+    world.release(first);
+    EXPECT_EQ(world.freeSlots(), 1u);
+}
+
+// перерождения в тех же слотах не копят старые имена
+TEST_F(WorldTest, RespawnDoesNotGrowNameTable) {
+    for (int round = 0; round < 1000; ++round) {
+        world.kill(toad_id);
+        world.release(toad_id);
+        EXPECT_EQ(world.spawn(NpcType::Toad, "Spawn_" + std::to_string(round), 1, 1), toad_id);
+    }
+    EXPECT_EQ(world.getName(toad_id), "Spawn_999");
+    EXPECT_EQ(world.getName(dragon_id), "WorldDragon");
+    EXPECT_EQ(world.getName(knight_id), "WorldKnight");
+    EXPECT_LE(world.nameBytes(), 2 * (9 + 11 + 11));
+}
+
+TEST_F(WorldTest, CompactFillsHolesFromTail) {
+    world.kill(toad_id);
+    world.release(toad_id);
+    std::vector<World::SlotMove> moved;
+    world.compact(moved);
+    ASSERT_EQ(moved.size(), 1u);
+    EXPECT_EQ(moved[0].from, knight_id);
+    EXPECT_EQ(moved[0].to, toad_id);
+    EXPECT_EQ(world.size(), 2u);
+    EXPECT_EQ(world.freeSlots(), 0u);
+    EXPECT_EQ(world.getName(toad_id), "WorldKnight");
+    EXPECT_EQ(world.getUid(toad_id), 2u);
+    EXPECT_EQ(world.getX(toad_id), 50);
+    EXPECT_EQ(world.getKillDist(toad_id), 10);
+
+    world.kill(0);
+    world.kill(1);
+    world.compact(moved);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(world.size(), 0u);
+
+    World::Id id = world.spawn(NpcType::Knight, "Again", 3, 3);
+    EXPECT_EQ(id, 0u);
+    EXPECT_EQ(world.getName(0), "Again");
+    EXPECT_EQ(world.getUid(0), 3u);
+}
+
+TEST_F(WorldTest, PooledFacadesOutliveEachOther) {
+    std::vector<std::shared_ptr<NPC>> facades;
+    for (int i = 0; i < 100; ++i) {
+        facades.push_back(world.npc(static_cast<World::Id>(i % 3)));
+    }
+    facades.erase(facades.begin(), facades.begin() + 50);
+    auto again = world.npc(dragon_id);
+    EXPECT_EQ(again->getName(), "WorldDragon");
+    EXPECT_EQ(facades.back()->getX(), world.getX(static_cast<World::Id>(99 % 3)));
+}
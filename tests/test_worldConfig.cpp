@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "worldConfig.h"
+#include "knight.h"
+#include "rng.h"
+
+namespace {
+
+// подменяет активную конфигурацию на время теста
+class WorldConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override { saved = worldConfig(); }
+    void TearDown() override { setWorldConfig(saved); }
+
+    WorldConfig saved;
+};
+
+}
+
+TEST_F(WorldConfigTest, DefaultsMatchClassicGame) {
+    WorldConfig config;
+    EXPECT_EQ(config.width, 100);
+    EXPECT_EQ(config.height, 100);
+    EXPECT_EQ(config.npc_count, 50u);
+    EXPECT_EQ(config.duration, 30);
+    EXPECT_TRUE(config.contains(100, 0));
+    EXPECT_FALSE(config.contains(101, 0));
+    EXPECT_FALSE(config.contains(0, -1));
+}
+
+TEST_F(WorldConfigTest, ParsesKeyValueFile) {
+    std::istringstream file(
+        "# big run\n"
+        "width = 100000\n"
+        "height=50000   # comment\n"
+        "\n"
+        "npcs = 1000000\n"
+        "duration = 5\n");
+    WorldConfig config = parseWorldConfig(file);
+    EXPECT_EQ(config.width, 100000);
+    EXPECT_EQ(config.height, 50000);
+    EXPECT_EQ(config.npc_count, 1000000u);
+    EXPECT_EQ(config.duration, 5);
+}
+
+TEST_F(WorldConfigTest, ReportsBadLine) {
+    std::istringstream unknown("width = 10\ncolor = red\n");
+    try {
+        parseWorldConfig(unknown);
+        FAIL() << "expected invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_NE(std::string(e.what()).find("line 2"), std::string::npos);
+    }
+
+    std::istringstream not_number("height = 12abc\n");
+    EXPECT_THROW(parseWorldConfig(not_number), std::invalid_argument);
+    std::istringstream no_eq("width 10\n");
+    EXPECT_THROW(parseWorldConfig(no_eq), std::invalid_argument);
+}
+
+TEST_F(WorldConfigTest, RejectsBadSizes) {
+    WorldConfig config;
+    config.width = 0;
+    EXPECT_THROW(setWorldConfig(config), std::invalid_argument);
+    config.width = WorldConfig::MAX_SIDE + 1;
+    EXPECT_THROW(setWorldConfig(config), std::invalid_argument);
+    EXPECT_EQ(worldConfig().width, saved.width);
+}
+
+// значение за пределами int не оборачивается в допустимое
+TEST_F(WorldConfigTest, RejectsValuesThatDoNotFitInt) {
+    WorldConfig config;
+    EXPECT_THROW(setConfigValue(config, "width", "4294967297"), std::invalid_argument);
+    EXPECT_THROW(setConfigValue(config, "height", "-4294967295"), std::invalid_argument);
+    EXPECT_THROW(setConfigValue(config, "duration", "4294967296"), std::invalid_argument);
+    EXPECT_EQ(config.width, 100);
+    EXPECT_EQ(config.height, 100);
+    EXPECT_EQ(config.duration, 30);
+
+    std::istringstream file("width = 4294967297\n");
+    EXPECT_THROW(parseWorldConfig(file), std::invalid_argument);
+}
+
+TEST_F(WorldConfigTest, NpcBoundsFollowConfig) {
+    WorldConfig config;
+    config.width = 100000;
+    config.height = 200;
+    setWorldConfig(config);
+
+    EXPECT_NO_THROW(Knight("FarKnight", 99999, 200));
+    EXPECT_THROW(Knight("OffMap", 50, 201), std::runtime_error);
+}
+
+TEST_F(WorldConfigTest, MovementStaysInsideSmallMap) {
+    WorldConfig config;
+    config.width = 3;
+    config.height = 3;
+    setWorldConfig(config);
+
+    CounterRng rng(1, RngStream::Move, 0, 0);
+    for (int i = 0; i < 1000; ++i) {
+        int x = 1, y = 2;
+        randomStep(x, y, 30, rng);
+        EXPECT_TRUE(worldConfig().contains(x, y));
+    }
+}
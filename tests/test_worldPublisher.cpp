@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "worldPublisher.h"
+
+namespace {
+
+// count нпс, все в точке (value, value)
+World makeWorld(int count, int value) {
+    World world;
+    for (int i = 0; i < count; ++i) {
+        world.add(NpcType::Toad, "Toad", value, value);
+    }
+    return world;
+}
+
+}
+
+TEST(WorldPublisherTest, EmptyBeforeFirstPublish) {
+    WorldPublisher publisher;
+    auto frame = publisher.read();
+    EXPECT_EQ(frame->tick, 0u);
+    EXPECT_EQ(frame->size(), 0u);
+}
+
+TEST(WorldPublisherTest, ReadSeesLatestVersion) {
+    WorldPublisher publisher;
+    World world = makeWorld(3, 5);
+    world.kill(1);
+    EXPECT_TRUE(publisher.publish(world, 7));
+
+    auto frame = publisher.read();
+    EXPECT_EQ(frame->tick, 7u);
+    ASSERT_EQ(frame->size(), 3u);
+    EXPECT_EQ(frame->xs[2], 5);
+    EXPECT_EQ(frame->alive[1], 0);
+    EXPECT_EQ(frame->alive_count, 2u);
+    EXPECT_EQ(frame->types[0], static_cast<std::uint8_t>(NpcType::Toad));
+}
+
+TEST(WorldPublisherTest, PinnedVersionSurvivesLaterPublishes) {
+    WorldPublisher publisher;
+    publisher.publish(makeWorld(1, 1), 1);
+    auto pinned = publisher.read();
+    for (std::uint32_t tick = 2; tick < 10; ++tick) {
+        publisher.publish(makeWorld(1, static_cast<int>(tick)), tick);
+    }
+    EXPECT_EQ(pinned->tick, 1u);
+    EXPECT_EQ(pinned->xs[0], 1);
+    EXPECT_EQ(publisher.read()->tick, 9u);
+}
+
+TEST(WorldPublisherTest, SkipsWhenEverySlotIsPinned) {
+    WorldPublisher publisher;
+    std::vector<std::optional<WorldPublisher::ReadGuard>> guards;
+    World world = makeWorld(1, 0);
+    for (std::uint32_t tick = 1; tick < WorldPublisher::SLOTS; ++tick) {
+        guards.emplace_back(publisher.read());
+        ASSERT_TRUE(publisher.publish(world, tick));
+    }
+    guards.emplace_back(publisher.read());
+
+    // писатель не ждет, текущая версия остается прежней
+    EXPECT_FALSE(publisher.publish(world, 100));
+    EXPECT_EQ(publisher.skipped(), 1u);
+    EXPECT_EQ(publisher.read()->tick, WorldPublisher::SLOTS - 1);
+
+    guards.front().reset();
+    EXPECT_TRUE(publisher.publish(world, 101));
+    EXPECT_EQ(publisher.read()->tick, 101u);
+}
+
+TEST(WorldPublisherTest, ReadersNeverSeeTornVersion) {
+    WorldPublisher publisher;
+    const int count = 1000;
+    std::vector<World> worlds;
+    for (int v = 0; v < 8; ++v) {
+        worlds.push_back(makeWorld(count, v));
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done) {
+                auto frame = publisher.read();
+                if (frame->size() == 0) continue;
+                int expected = static_cast<int>(frame->tick % 8);
+                for (std::size_t i = 0; i < frame->size(); ++i) {
+                    if (frame->xs[i] != expected || frame->ys[i] != expected) {
+                        torn.fetch_add(1);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::uint32_t tick = 1; tick <= 2000; ++tick) {
+        publisher.publish(worlds[tick % 8], tick);
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(publisher.published() + publisher.skipped(), 2000u);
+}
@@ -0,0 +1,155 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "eventLog.h"
+#include "registry.h"
+
+// запросы к двоичному журналу боев; идут по одной сессии, по умолчанию последней:
+//   eventlog FILE [--session N] kills [--from T] [--to T] [--window N]
+//   eventlog FILE [--session N] history ID
+//   eventlog FILE [--session N] stats
+//   eventlog FILE sessions
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: eventlog FILE [--session N] kills [--from T] [--to T] [--window N]\n"
+              << "       eventlog FILE [--session N] history ID\n"
+              << "       eventlog FILE [--session N] stats\n"
+              << "       eventlog FILE sessions" << std::endl;
+    return 2;
+}
+
+// скорость скана в stderr, чтобы не мешать выводу запроса
+void reportScan(const EventLogReader& reader, std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mb = static_cast<double>(reader.bytesRead()) / (1024.0 * 1024.0);
+    std::fprintf(stderr, "scanned %.1f MB in %.3f ms (%.0f MB/s)%s\n", mb, seconds * 1000,
+                 seconds > 0 ? mb / seconds : 0.0, reader.truncated() ? ", truncated tail skipped" : "");
+}
+
+std::string startTime(std::uint64_t start_ms) {
+    std::time_t seconds = static_cast<std::time_t>(start_ms / 1000);
+    char text[32];
+    std::tm utc{};
+    if (!gmtime_r(&seconds, &utc) || std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S UTC", &utc) == 0) return "?";
+    return text;
+}
+
+std::string npcLabel(std::uint8_t type, std::uint32_t id) {
+    std::string kind = type < NPC_KIND_COUNT ? std::string(KIND_INFO[type].name) : "?";
+    return kind + " #" + (id == NO_NPC_ID ? std::string("?") : std::to_string(id));
+}
+
+int kills(EventLogReader& reader, int argc, char** argv) {
+    std::uint32_t from = 0;
+    std::uint32_t to = UINT32_MAX;
+    std::uint32_t window = 0;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        auto value = static_cast<std::uint32_t>(std::stoul(argv[i + 1]));
+        if (arg == "--from") {
+            from = value;
+        } else if (arg == "--to") {
+            to = value;
+        } else if (arg == "--window") {
+            window = value;
+        } else {
+            return usage();
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto windows = killsPerSpecies(reader, from, to, window);
+    reportScan(reader, start);
+
+    std::cout << "from_tick";
+    for (const auto& info : KIND_INFO) std::cout << '\t' << info.name;
+    std::cout << '\n';
+    for (const auto& w : windows) {
+        std::cout << w.from_tick;
+        for (std::uint64_t k : w.kills) std::cout << '\t' << k;
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+int history(EventLogReader& reader, std::uint32_t id) {
+    auto start = std::chrono::steady_clock::now();
+    auto records = npcHistory(reader, id);
+    reportScan(reader, start);
+
+    for (const auto& r : records) {
+        std::cout << "tick " << r.tick << ": " << npcLabel(r.attacker_type, r.attacker) << " -> "
+                  << npcLabel(r.defender_type, r.defender) << " at (" << r.x << ", " << r.y << ") "
+                  << (r.killed ? "killed" : r.success ? "lost the roll" : "no kill") << '\n';
+    }
+    return 0;
+}
+
+int sessions(const EventLogReader& reader) {
+    std::cout << "session\tseed\tstarted\trecords\tticks\n";
+    for (std::size_t i = 0; i < reader.sessions().size(); ++i) {
+        const EventSession& s = reader.sessions()[i];
+        std::cout << i << '\t' << s.seed << '\t' << startTime(s.start_ms) << '\t' << s.records << '\t';
+        if (s.records > 0) {
+            std::cout << s.first_tick << ".." << s.last_tick;
+        } else {
+            std::cout << '-';
+        }
+        std::cout << '\n';
+    }
+    return 0;
+}
+
+int stats(EventLogReader& reader) {
+    std::uint64_t blocks = 0;
+    std::uint64_t records = 0;
+    std::uint32_t first = UINT32_MAX;
+    std::uint32_t last = 0;
+    auto start = std::chrono::steady_clock::now();
+    reader.scan(
+        [&](const EventBlockHeader& header) {
+            ++blocks;
+            records += header.count;
+            first = std::min(first, header.min_tick);
+            last = std::max(last, header.max_tick);
+            return false;
+        },
+        [](const EventBlockHeader&, const EventRecord*, std::size_t) {});
+    reportScan(reader, start);
+
+    std::cout << "session: " << reader.selectedSession() << " of " << reader.sessions().size() << '\n';
+    std::cout << "blocks: " << blocks << "\nrecords: " << records << '\n';
+    if (records > 0) std::cout << "ticks: " << first << ".." << last << '\n';
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage();
+    try {
+        EventLogReader reader(argv[1]);
+        if (std::string(argv[2]) == "--session") {
+            if (argc < 5) return usage();
+            reader.selectSession(std::stoul(argv[3]));
+            argv += 2;  // дальше разбор как без --session
+            argc -= 2;
+        }
+        std::string command = argv[2];
+        if (command == "kills") return kills(reader, argc, argv);
+        if (command == "history" && argc == 4) return history(reader, static_cast<std::uint32_t>(std::stoul(argv[3])));
+        if (command == "stats") return stats(reader);
+        if (command == "sessions") return sessions(reader);
+        return usage();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}